@@ -1,36 +1,162 @@
 /// \file exampleB1.cc
 /// \brief Main program of the B1 example
 
-#include "ActionInitialization.hh"
 #include "DetectorConstruction.hh"
-
-#include "G4RunManagerFactory.hh"
-#include "G4SteppingVerbose.hh"
+#include "DirectionalTally.hh"
+#include "DoseSums.hh"
+#include "FieldValidation.hh"
+#include "LightModel.hh"
+#include "PhysicsComparison.hh"
+#include "RunOptions.hh"
+#include "Simulation.hh"
+#include "StatisticsTally.hh"
+
+#include "G4Box.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Tubs.hh"
 #include "G4UIExecutive.hh"
 #include "G4UImanager.hh"
-#include "G4VisExecutive.hh"
-#include "G4SystemOfUnits.hh"
-#include "G4VModularPhysicsList.hh"
-#include "G4LossTableManager.hh"
-#include "G4StepLimiterPhysics.hh"
-#include "G4EmStandardPhysics_option3.hh"
 #include "G4UnitsTable.hh"
+#include "G4VisExecutive.hh"
 
+#include <cmath>
 #include <filesystem>
+#include <fstream>
+#include <vector>
 
 using namespace B1;
 
-int main(int argc, char** argv){
+// Result files of a sweep
+struct OutputFiles{
+
+    std::string dose = "output.txt";
+    std::string light = "light.txt";
+    std::string performance = "performance.txt";
+    std::string response = "response.txt";
+    std::string statistics = "statistics.txt";
+    std::string convergence = "convergence.txt";
+
+};
+
+// Append the results of one energy point to the output files
+void WriteOutputRow(const OutputFiles& files, const PointResult& result, G4double gaggMass, G4double plasticMass){
+
+    if (!std::filesystem::exists(files.dose)) return;
+
+    // Sums over the events of the row with the geometric weight of the
+    // source; the number of events differs between points served from the
+    // cache or allocated by the time budget
+    G4double energy = result.energy;
+    const DoseSums& sums = result.sums;
 
-    // RunManager
-    G4RunManager* runManager = nullptr;
+    std::ofstream file;
+    file.open(files.dose, std::ios::app);
+    file << energy / MeV << "\t" << sums.nEvents << "\t" << result.eDepGAGG / GeV << "\t" << result.rmsEDepGAGG / GeV << "\t" << result.eDepPlastic / GeV << "\t" << result.rmsEDepPlastic / GeV << "\t" << result.doseGAGG / gray << "\t" << result.rmsDoseGAGG / gray << "\t" << result.dosePlastic / gray << "\t" << result.rmsDosePlastic / gray << "\n";
+    file.close();
+
+    // Light totals and pulse shapes of both volumes
+    if (sums.HasLight()) {
+
+        std::ofstream lightFile;
+        lightFile.open(files.light, std::ios::app);
+        lightFile << energy / MeV << "\t" << sums.nEvents << "\t" << sums.lightGAGG << "\t" << sums.RmsLightGAGG() << "\t" << sums.lightPlastic << "\t" << sums.RmsLightPlastic();
+        for (auto value : sums.profileGAGG) lightFile << "\t" << value;
+        for (auto value : sums.profilePlastic) lightFile << "\t" << value;
+        lightFile << "\n";
+
+    }
+
+    // Uncertainty diagnostics of the mean deposit per event
+    if (sums.HasStatistics()) {
+
+        std::ofstream statisticsFile;
+        statisticsFile.open(files.statistics, std::ios::app);
+        statisticsFile << energy / MeV << "\t" << sums.nEvents;
+        size_t nBatches = sums.NumberOfBatches();
+        const StreamingStats* stats[2] = {&sums.statsGAGG, &sums.statsPlastic};
+        G4double batchErrors[2] = {sums.BatchErrorGAGG(nBatches), sums.BatchErrorPlastic(nBatches)};
+        for (G4int volume = 0; volume < 2; ++volume) {
+
+            statisticsFile << "\t" << stats[volume]->mean / MeV << "\t" << stats[volume]->StandardError() / MeV << "\t" << batchErrors[volume] / MeV
+                << "\t" << stats[volume]->VarianceOfVariance() << "\t" << stats[volume]->Skewness() << "\t" << stats[volume]->ExcessKurtosis();
+
+        }
+        statisticsFile << "\n";
+
+    }
+
+    // Running mean and batch-means error after each batch
+    if (sums.NumberOfBatches() > 1) {
+
+        std::ofstream convergenceFile;
+        convergenceFile.open(files.convergence, std::ios::app);
+        G4double n = 0.;
+        G4double sumGAGG = 0.;
+        G4double sumPlastic = 0.;
+        for (size_t i = 0; i < sums.NumberOfBatches(); ++i) {
+
+            const G4double* batch = &sums.batches[i * StatisticsTally::fNValues];
+            n += batch[0];
+            sumGAGG += batch[1];
+            sumPlastic += batch[2];
+            convergenceFile << energy / MeV << "\t" << i + 1 << "\t" << n
+                << "\t" << sumGAGG / n / MeV << "\t" << sums.BatchErrorGAGG(i + 1) / MeV
+                << "\t" << sumPlastic / n / MeV << "\t" << sums.BatchErrorPlastic(i + 1) / MeV << "\n";
+
+        }
+
+    }
+
+    // Dose per unit fluence of a broad beam from each direction bin
+    if (sums.HasDirectional()) {
+
+        std::ofstream responseFile;
+        responseFile.open(files.response, std::ios::app);
+        G4int nBins = static_cast<G4int>(sums.directional.size()) / DirectionalTally::fNValues;
+        for (G4int bin = 0; bin < nBins; ++bin) {
+
+            const G4double* values = &sums.directional[bin * DirectionalTally::fNValues];
+            G4double n = values[0];
+            G4double cosMin = -1. + 2. * bin / nBins;
+            G4double cosMax = -1. + 2. * (bin + 1) / nBins;
+
+            auto error = [n](G4double m2) {
+
+                return m2 > 0. ? std::sqrt(m2) / n : 0.;
+
+            };
+
+            responseFile << energy / MeV << "\t" << cosMin << "\t" << cosMax << "\t" << n;
+            if (n > 0.) {
+
+                responseFile << "\t" << values[1] / n / gaggMass / gray << "\t" << error(values[2]) / gaggMass / gray
+                    << "\t" << values[3] / n / plasticMass / gray << "\t" << error(values[4]) / plasticMass / gray;
+
+            }
+            else {
+
+                responseFile << "\t0\t0\t0\t0";
+
+            }
+            responseFile << "\n";
+
+        }
+
+    }
+
+}
+
+int main(int argc, char** argv){
 
     // Geometry parameters
-    G4double plasticDiameterInput = std::stod(argv[1]) * cm;
-    G4double plasticSizeZInput = std::stod(argv[2]) * cm;
-    G4double gaggSizeXInput = std::stod(argv[3]) * cm;
-    G4double gaggSizeYInput = std::stod(argv[4]) * cm;
-    G4double gaggSizeZInput = std::stod(argv[5]) * cm;
+    SimulationConfig config;
+    config.geometry.plasticDiameter = std::stod(argv[1]) * cm;
+    config.geometry.plasticSizeZ = std::stod(argv[2]) * cm;
+    config.geometry.gaggSizeX = std::stod(argv[3]) * cm;
+    config.geometry.gaggSizeY = std::stod(argv[4]) * cm;
+    config.geometry.gaggSizeZ = std::stod(argv[5]) * cm;
 
     // Run parameters
     G4double energyMin = 0.;
@@ -41,19 +167,20 @@ int main(int argc, char** argv){
     G4double indexMin = 0.;
     G4double indexMax = 0.;
 
+    // Optional settings following the positional arguments
+    RunOptions& options = config.options;
+
     // Detect interactive mode (if only geometry parameters passed) and define UI session
     G4UIExecutive* ui = nullptr;
     if (argc == 6) {
 
-        runManager = G4RunManagerFactory::CreateRunManager(G4RunManagerType::SerialOnly);
+        config.interactive = true;
         ui = new G4UIExecutive(argc, argv);
 
     }
 
     else{
 
-        runManager = G4RunManagerFactory::CreateRunManager(G4RunManagerType::Default);
-
         // Run parameters
         energyMin = std::stod(argv[6]) * MeV;
         energyMax = std::stod(argv[7]) * MeV;
@@ -63,27 +190,18 @@ int main(int argc, char** argv){
         indexMin = std::log10(energyMin/MeV);
         indexMax = std::log10(energyMax/MeV);
 
+        options = ParseRunOptions(argc, argv, 10);
+
+        // The comparison harness only drives child processes
+        if (!options.comparePhysics.empty()) return RunPhysicsComparison(argc, argv, options);
+        if (options.validateField) return RunFieldValidation(argc, argv, options);
+
     }
 
-    // DetectorConstruction
-    auto detectorConstruction = new DetectorConstruction();
-	detectorConstruction->SetPlasticDimensions(plasticDiameterInput, plasticSizeZInput);
-	detectorConstruction->SetGAAGDimensions(gaggSizeXInput, gaggSizeYInput, gaggSizeZInput);
-    runManager->SetUserInitialization(detectorConstruction);
-
-    // Physics list
-    G4VModularPhysicsList* physicsList = new G4VModularPhysicsList();
-	G4LossTableManager::Instance();
-	physicsList->SetDefaultCutValue(0.01*mm);
-	physicsList->RegisterPhysics(new G4EmStandardPhysics_option3);
-	G4StepLimiterPhysics* stepLimitPhys = new G4StepLimiterPhysics();
-	stepLimitPhys->SetApplyToAll(true);
-	physicsList->RegisterPhysics(stepLimitPhys);
-	runManager->SetUserInitialization(physicsList);
-
-    // ActionInitialization
-    runManager->SetUserInitialization(new ActionInitialization());
-    runManager->Initialize();
+    // Run manager, detector, physics and actions
+    Simulation simulation(config);
+    const DetectorConstruction* detectorConstruction = simulation.GetDetectorConstruction();
+    G4double sourceWeight = simulation.GetSourceWeight();
 
     // Initialize visualization with the default graphics system
     auto visManager = new G4VisExecutive(argc, argv);
@@ -117,19 +235,28 @@ int main(int argc, char** argv){
     G4double plasticDensity = plasticLV->GetMaterial()->GetDensity();
 
     // Print parameters in output file
-    std::string filename = "output.txt";
+    OutputFiles files;
+    std::string filename = files.dose;
     std::ofstream outFile(filename);
     if (outFile) {
         std::cout << "File created successfully: " << filename << std::endl;
 
-        outFile << "nEvents = " << nEvents << "\n";
+        if (options.sourceMode != SourceMode::Pencil) {
+
+            outFile << "Source = " << SourceModeName(options.sourceMode)
+                << " distance = " << G4BestUnit(options.sourceDistance, "Length")
+                << " angle = " << options.sourceAngle / deg << " deg"
+                << " weight = " << sourceWeight
+                << (options.sourceMode == SourceMode::Point ? " (per emitted photon)" : " (per photon/cm2)") << "\n";
+
+        }
         outFile << "GAAG:" << "\n";
         outFile << "dx = " << G4BestUnit(gaggSizeX, "Length") << " dy = " << G4BestUnit(gaggSizeY, "Length") << " dz = " << G4BestUnit(gaggSizeZ, "Length") << "\n";
         outFile << "Density = " << G4BestUnit(gaggDensity, "Volumic Mass") << " Volume = " << G4BestUnit(gaggVolume, "Volume") << " Mass = " << G4BestUnit(gaggMass, "Mass") << "\n";
         outFile << "Plastic:" << "\n";
         outFile << "r = " << G4BestUnit(plasticRadius, "Length") << " h = " << G4BestUnit(plasticSizeZ, "Length") << "\n";
         outFile << "Density = " << G4BestUnit(plasticDensity, "Volumic Mass") << " Volume = " << G4BestUnit(plasticVolume, "Volume") << " Mass = " << G4BestUnit(plasticMass, "Mass") << "\n";
-        outFile << "photonEnergy / MeV" << "\t" << "eDepGAGG / GeV" << "\t" << "dEDepGAGG / GeV" << "\t" << "eDepPlastic / GeV" << "\t" << "dEDepPlastic / GeV" << "\t" << "doseGAGG / Gy" << "\t" << "dDoseGAGG / Gy" << "\t" << "dosePlastic / Gy" << "\t" << "dDosePlastic / Gy" << "\n";
+        outFile << "photonEnergy / MeV" << "\t" << "nEvents" << "\t" << "eDepGAGG / GeV" << "\t" << "dEDepGAGG / GeV" << "\t" << "eDepPlastic / GeV" << "\t" << "dEDepPlastic / GeV" << "\t" << "doseGAGG / Gy" << "\t" << "dDoseGAGG / Gy" << "\t" << "dosePlastic / Gy" << "\t" << "dDosePlastic / Gy" << "\n";
 
         outFile.close();
     }
@@ -137,41 +264,83 @@ int main(int argc, char** argv){
         std::cerr << "Failed to create the file: " << filename << std::endl;
     }
 
+    // Timing and step counts per run
+    if (options.performanceLog) {
+
+        std::ofstream performanceFile(files.performance);
+        performanceFile << "photonEnergy / MeV" << "\t" << "nEvents" << "\t" << "wallTime / s" << "\t" << "nSteps" << "\t" << "busyTime / s" << "\t" << "idleTime / s" << "\t" << "tailTime / s" << "\t" << "source" << "\n";
+
+    }
+
+    // Directional response file of the field source
+    if (options.sourceMode == SourceMode::Field) {
+
+        std::ofstream responseFile(files.response);
+        responseFile << "Dose per unit fluence of a broad beam travelling along cos(theta) to the z axis" << "\n";
+        responseFile << "photonEnergy / MeV" << "\t" << "cosThetaMin" << "\t" << "cosThetaMax" << "\t" << "nEvents"
+            << "\t" << "responseGAGG / (Gy cm2)" << "\t" << "dResponseGAGG / (Gy cm2)" << "\t" << "responsePlastic / (Gy cm2)" << "\t" << "dResponsePlastic / (Gy cm2)" << "\n";
+
+    }
+
+    // Uncertainty diagnostics and convergence history of every point
+    {
+
+        std::ofstream statisticsFile(files.statistics);
+        statisticsFile << "Mean deposit per event, standard error from the streaming variance and from " << options.nBatches << " batch means per run, relative variance of the variance (VOV), skewness and excess kurtosis" << "\n";
+        statisticsFile << "photonEnergy / MeV" << "\t" << "nEvents";
+        for (std::string volume : {"GAGG", "Plastic"}) {
+
+            statisticsFile << "\t" << "meanEDep" << volume << " / MeV" << "\t" << "errorEDep" << volume << " / MeV" << "\t" << "batchErrorEDep" << volume << " / MeV"
+                << "\t" << "vov" << volume << "\t" << "skewness" << volume << "\t" << "kurtosis" << volume;
+
+        }
+        statisticsFile << "\n";
+
+        std::ofstream convergenceFile(files.convergence);
+        convergenceFile << "photonEnergy / MeV" << "\t" << "nBatches" << "\t" << "nEvents"
+            << "\t" << "meanEDepGAGG / MeV" << "\t" << "batchErrorEDepGAGG / MeV" << "\t" << "meanEDepPlastic / MeV" << "\t" << "batchErrorEDepPlastic / MeV" << "\n";
+
+    }
+
+    // Light output file
+    if (options.lightModel) {
+
+        std::ofstream lightFile(files.light);
+        lightFile << "Light model: Birks-quenched yield, profile of " << LightModel::fNBins << " bins of " << G4BestUnit(LightModel::fBinWidth, "Time") << "\n";
+        lightFile << "photonEnergy / MeV" << "\t" << "nEvents" << "\t" << "lightGAGG / photons" << "\t" << "dLightGAGG / photons" << "\t" << "lightPlastic / photons" << "\t" << "dLightPlastic / photons"
+            << "\t" << "profileGAGG[" << LightModel::fNBins << "] / photons" << "\t" << "profilePlastic[" << LightModel::fNBins << "] / photons" << "\n";
+
+    }
+
     // Process macro or start UI session
     if (!ui) {
 
         // Batch mode
+        std::vector<G4double> energies;
         for (G4double index = indexMin; index <= (indexMax + energyStep); index += energyStep) {
 
-            G4double energy = std::pow(10, index);
+            energies.push_back(std::pow(10, index));
+
+        }
+
+        // Rows of every point as soon as it is final
+        simulation.Sweep(energies, nEvents, [&](const PointResult& result) {
+
+            WriteOutputRow(files, result, gaggMass, plasticMass);
+
+            if (options.performanceLog) {
+
+                std::ofstream performanceFile(files.performance, std::ios::app);
+                for (const auto& run : result.runs) {
+
+                    performanceFile << result.energy / MeV << "\t" << run.nEvents << "\t" << run.wallTime << "\t" << run.nSteps
+                        << "\t" << run.busyTime << "\t" << run.idleTime << "\t" << run.tailTime << "\t" << (run.cached ? "cache" : "run") << "\n";
+
+                }
 
-            if (std::filesystem::exists(filename)) {
-                std::ofstream file;
-                file.open(filename, std::ios::app);
-                file << energy / MeV << "\t";
-                file.close();
             }
 
-            std::cout << energy << "\n";
-            UImanager->ApplyCommand("/gun/particle gamma");
-            std::ostringstream energyCmd;
-            energyCmd << "/gun/energy " << G4BestUnit(energy, "Energy");
-            std::cout << energyCmd.str() << "\n";
-            UImanager->ApplyCommand(energyCmd.str());
-
-            std::ostringstream beamOnCmd;
-            beamOnCmd << "/run/beamOn " << nEvents;
-
-            G4cout
-            << G4endl
-            << "------------------------------------------------------------"
-            << G4endl
-            << "The run consists of " << nEvents << " gammas of energy " << G4BestUnit(energy, "Energy")
-            << G4endl;
-
-            UImanager->ApplyCommand(beamOnCmd.str());
-            
-        }
+        });
 
     }
     else {
@@ -184,6 +353,5 @@ int main(int argc, char** argv){
     }
 
     delete visManager;
-    delete runManager;
     
-}
\ No newline at end of file
+}
@@ -30,21 +30,40 @@
 #ifndef B1ActionInitialization_h
 #define B1ActionInitialization_h 1
 
+#include "LightModel.hh"
+#include "RunOptions.hh"
+
 #include "G4VUserActionInitialization.hh"
 
+#include <memory>
+
 namespace B1
 {
 
+class RunAction;
+
 /// Action initialization class.
 
 class ActionInitialization : public G4VUserActionInitialization
 {
   public:
-    ActionInitialization() = default;
+    ActionInitialization(const RunOptions& options = RunOptions());
     ~ActionInitialization() override = default;
 
     void BuildForMaster() const override;
     void Build() const override;
+
+  private:
+    RunAction* BuildMasterRunAction() const;
+
+    RunOptions fOptions;
+
+    // Run action of the master, owned by the run manager
+    mutable RunAction* fMasterRunAction = nullptr;
+
+    // Read-only light models shared by the event actions of all workers
+    std::unique_ptr<const LightModel> fLightModelPlastic;
+    std::unique_ptr<const LightModel> fLightModelGAGG;
 };
 
 }  // namespace B1
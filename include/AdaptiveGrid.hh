@@ -0,0 +1,31 @@
+/// \file B1/include/AdaptiveGrid.hh
+/// \brief Definition of the adaptive energy-grid refinement
+
+#ifndef B1AdaptiveGrid_h
+#define B1AdaptiveGrid_h 1
+
+#include "DoseSums.hh"
+
+#include "globals.hh"
+
+namespace B1{
+
+    /// One simulated point of an adaptive sweep, at the energy it was
+    /// simulated with and in log10(E / MeV).
+
+    struct GridPoint{
+
+        G4double energy = 0.;
+        G4double logEnergy = 0.;
+        DoseSums sums;
+
+    };
+
+    // Significance of the interpolation error at a point: the deviation of
+    // its deposits from the log-log interpolation between its neighbours, in
+    // units of the combined statistical uncertainty (worst of both volumes)
+    G4double InterpolationSignificance(const GridPoint& left, const GridPoint& point, const GridPoint& right);
+
+}
+
+#endif
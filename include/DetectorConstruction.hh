@@ -28,6 +28,13 @@ namespace B1{
             void SetPlasticDimensions(G4double diameter, G4double sizeZ);
             void SetGAAGDimensions(G4double sizeX, G4double sizeY, G4double sizeZ);
 
+            // The world is enlarged to contain a sphere of this radius around the detector
+            void SetSourceExtent(G4double extent) { sourceExtent = extent; }
+
+            // Incremented by every Construct(), so cached volume and solid
+            // pointers can be refreshed when the geometry is rebuilt
+            static G4int GetGeometryVersion();
+
         protected:
 
             G4LogicalVolume* fScoringVolumePlastic = nullptr;
@@ -38,6 +45,7 @@ namespace B1{
             G4double gaggSizeZ = 2.0 * cm;
             G4double plasticDiameter = 2.1 * cm;
             G4double plasticSizeZ = 2.0 * cm;
+            G4double sourceExtent = 0.;
 
     };
 
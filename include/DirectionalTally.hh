@@ -0,0 +1,66 @@
+/// \file B1/include/DirectionalTally.hh
+/// \brief Definition of the B1::DirectionalTally class
+
+#ifndef B1DirectionalTally_h
+#define B1DirectionalTally_h 1
+
+#include "ExactSum.hh"
+
+#include "G4ThreeVector.hh"
+#include "G4VAccumulable.hh"
+#include "G4Version.hh"
+#include "globals.hh"
+
+#include <vector>
+
+namespace B1{
+
+    /// Accumulable of the per-event deposits of the field source binned by
+    /// the primary energy, when a run covers several energies, and by the
+    /// direction of the primary, in equal solid-angle bins of cos(theta) from
+    /// the z axis. The deposits are summed exactly (see ExactSum). Each bin
+    /// of the values holds the number of events and the sums and sums of
+    /// squared deviations from the mean (M2) of the GAGG and plastic deposits,
+    /// flattened in this order, the direction bins of the first energy first.
+
+    class DirectionalTally : public G4VAccumulable{
+
+        public:
+
+            DirectionalTally(const G4String& name, G4int nDirectionBins);
+            ~DirectionalTally() override = default;
+
+            static constexpr G4int fNValues = 5;
+
+            static G4int Bin(const G4ThreeVector& direction, G4int nDirectionBins);
+
+            // Number of energies of the next run, on every thread before it
+            // starts; clears the tally
+            void SetNumberOfEnergies(G4int nEnergies);
+
+            // Bin of energy index i and direction bin j is i * nDirectionBins + j
+            void Add(G4int bin, G4double eDepGAGG, G4double eDepPlastic);
+
+            void Merge(const G4VAccumulable& other) override;
+            void Reset() override;
+#if G4VERSION_NUMBER >= 1130
+            void Print(G4PrintOptions options = G4PrintOptions()) const override;
+#endif
+
+            G4int GetNumberOfDirectionBins() const { return fNDirectionBins; }
+            std::vector<G4double> GetValues() const;
+
+            // Merge of flattened values, also used for the sums of several runs
+            static void MergeBins(std::vector<G4double>& values, const std::vector<G4double>& other);
+
+        private:
+
+            G4int fNDirectionBins = 1;
+            std::vector<ExactSum> fGAGG;
+            std::vector<ExactSum> fPlastic;
+
+    };
+
+}
+
+#endif
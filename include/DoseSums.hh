@@ -0,0 +1,79 @@
+/// \file B1/include/DoseSums.hh
+/// \brief Definition of the B1::DoseSums structure
+
+#ifndef B1DoseSums_h
+#define B1DoseSums_h 1
+
+#include "StreamingStats.hh"
+
+#include "globals.hh"
+
+#include <vector>
+
+namespace B1{
+
+    /// Raw per-point statistics: number of events and the sums of the
+    /// per-event energy deposits and of their squared deviations from the
+    /// mean (M2) in both volumes, and the same for the scintillation light
+    /// with the summed time profiles when the light model is enabled
+    /// (profiles are empty otherwise), and the per-direction sums of the field
+    /// source (see DirectionalTally). The M2 of the deposits come from the
+    /// exact sums, so they are bit-identical for any thread count; the
+    /// sums of several runs combine pairwise. The streaming moments and batch
+    /// sums (see StatisticsTally), whose merge order follows the thread
+    /// scheduling, only feed the uncertainty diagnostics. The wall-clock time and
+    /// steps of the runs that produced the sums travel with them, so points
+    /// read back from the result cache still report their cost.
+
+    struct DoseSums{
+
+        G4long nEvents = 0;
+        G4double eDepGAGG = 0.;
+        G4double eDepM2GAGG = 0.;
+        G4double eDepPlastic = 0.;
+        G4double eDepM2Plastic = 0.;
+
+        G4double lightGAGG = 0.;
+        G4double lightM2GAGG = 0.;
+        G4double lightPlastic = 0.;
+        G4double lightM2Plastic = 0.;
+        std::vector<G4double> profileGAGG;
+        std::vector<G4double> profilePlastic;
+        std::vector<G4double> directional;
+
+        StreamingStats statsGAGG;
+        StreamingStats statsPlastic;
+        std::vector<G4double> batches;
+
+        G4double seconds = 0.;
+        G4long nSteps = 0;
+
+        void Merge(const DoseSums& other);
+
+        // Apply a constant per-event weight
+        void Scale(G4double weight);
+
+        G4double RmsEDepGAGG() const { return Rms(eDepM2GAGG); }
+        G4double RmsEDepPlastic() const { return Rms(eDepM2Plastic); }
+        G4double RmsLightGAGG() const { return Rms(lightM2GAGG); }
+        G4double RmsLightPlastic() const { return Rms(lightM2Plastic); }
+        G4bool HasLight() const { return !profileGAGG.empty(); }
+        G4bool HasDirectional() const { return !directional.empty(); }
+        G4bool HasStatistics() const { return statsGAGG.n == nEvents && nEvents > 0; }
+
+        // Batch-means standard error of the mean deposit per event over the
+        // first nBatches batches, in the order the events were run
+        size_t NumberOfBatches() const;
+        G4double BatchErrorGAGG(size_t nBatches) const { return BatchError(1, nBatches); }
+        G4double BatchErrorPlastic(size_t nBatches) const { return BatchError(2, nBatches); }
+
+        private:
+
+            G4double Rms(G4double m2) const;
+            G4double BatchError(size_t value, size_t nBatches) const;
+
+    };
+
+}
+
+#endif
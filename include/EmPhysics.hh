@@ -0,0 +1,26 @@
+/// \file B1/include/EmPhysics.hh
+/// \brief Definition of the selectable electromagnetic physics constructors
+
+#ifndef B1EmPhysics_h
+#define B1EmPhysics_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+class G4VPhysicsConstructor;
+
+namespace B1{
+
+    // Short names accepted by --physics: opt0 ... opt4, livermore, penelope, lowep
+    std::vector<G4String> EmPhysicsChoices();
+
+    // EM constructor for a short name, fatal for unknown names
+    G4VPhysicsConstructor* CreateEmPhysics(const G4String& choice);
+
+    // Class name of the constructor, used to identify the physics in results
+    G4String EmPhysicsClassName(const G4String& choice);
+
+}
+
+#endif
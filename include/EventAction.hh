@@ -4,9 +4,19 @@
 #ifndef B1EventAction_h
 #define B1EventAction_h 1
 
+#include "EventRecorder.hh"
+#include "LightModel.hh"
+#include "RunOptions.hh"
+#include "StepRecorder.hh"
+
 #include "G4UserEventAction.hh"
+#include "G4Version.hh"
 #include "globals.hh"
 
+#include <chrono>
+#include <memory>
+#include <vector>
+
 class G4Event;
 
 namespace B1{
@@ -17,14 +27,31 @@ namespace B1{
 
         public:
 
-            EventAction(RunAction* runAction);
+            EventAction(RunAction* runAction, const RunOptions& options = RunOptions(),
+                const LightModel* lightModelPlastic = nullptr, const LightModel* lightModelGAGG = nullptr);
             ~EventAction() override = default;
 
             void BeginOfEventAction(const G4Event* event) override;
             void EndOfEventAction(const G4Event* event) override;
+#if G4VERSION_NUMBER >= 1120
+            void MergeSubEvent(G4Event* masterEvent, const G4Event* subEvent) override;
+#endif
 
             void AddEDepPlastic(G4double eDep) { fEDepEventPlastic += eDep; }
             void AddEDepGAGG(G4double eDep) { fEDepEventGAGG += eDep; }
+            void CountStep() { ++fNStepsEvent; }
+
+            // Wall-clock timing of every event for the busy and idle time of
+            // the run, on unless switched off (the step replay times itself)
+            void SetEventTiming(G4bool timing) { fEventTiming = timing; }
+
+            // Recorder of the steps of this worker, null unless recording
+            StepRecorder* GetStepRecorder() const { return fStepRecorder.get(); }
+
+            // Scintillation light of a step, only when the light model is enabled
+            G4bool IsLightEnabled() const { return fLightModelGAGG != nullptr; }
+            void AddLightPlastic(G4double eDep, G4double stepLength, G4double time);
+            void AddLightGAGG(G4double eDep, G4double stepLength, G4double time);
 
         private:
 
@@ -32,6 +59,23 @@ namespace B1{
 
             G4double fEDepEventPlastic = 0.;
             G4double fEDepEventGAGG = 0.;
+            G4long fNStepsEvent = 0;
+            G4bool fEventTiming = true;
+            std::chrono::steady_clock::time_point fEventStart;
+
+            const LightModel* fLightModelPlastic = nullptr;
+            const LightModel* fLightModelGAGG = nullptr;
+            G4bool fDirectional = false;
+            G4int fDirectionBins = 1;
+            G4bool fSubEvents = false;
+            G4double fLightEventPlastic = 0.;
+            G4double fLightEventGAGG = 0.;
+            std::vector<G4double> fEmissionPlastic;
+            std::vector<G4double> fEmissionGAGG;
+            std::vector<G4double> fProfile;
+
+            std::unique_ptr<StepRecorder> fStepRecorder;
+            std::unique_ptr<EventRecorder> fEventRecorder;
 
     };
 
@@ -0,0 +1,37 @@
+/// \file B1/include/EventBudget.hh
+/// \brief Definition of the wall-clock budgeted event allocation
+
+#ifndef B1EventBudget_h
+#define B1EventBudget_h 1
+
+#include "DoseSums.hh"
+
+#include "globals.hh"
+
+#include <vector>
+
+namespace B1{
+
+    /// What a pilot run tells about one energy point: the events already
+    /// simulated, the cost of one more event and the relative variance of
+    /// the dose per event (relative uncertainty^2 times number of events).
+
+    struct PilotEstimate{
+
+        G4long nEvents = 0;
+        G4double secondsPerEvent = 0.;
+        G4double relativeVariance = 0.;
+
+    };
+
+    // Worst relative dose uncertainty of the two volumes (0 without deposits)
+    G4double RelativeVariance(const DoseSums& sums);
+
+    // Total number of events per point minimising the largest relative
+    // uncertainty of the sweep, given the seconds left for additional events.
+    // Points never go below their pilot statistics.
+    std::vector<G4long> AllocateEvents(const std::vector<PilotEstimate>& pilots, G4double seconds);
+
+}
+
+#endif
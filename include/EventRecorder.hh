@@ -0,0 +1,60 @@
+/// \file B1/include/EventRecorder.hh
+/// \brief Definition of the B1::EventRecorder class
+
+#ifndef B1EventRecorder_h
+#define B1EventRecorder_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+namespace B1{
+
+    /// Totals of one event: primary energy, deposits and scintillation light
+    /// of both volumes (zero without the light model).
+
+    struct EventRecord{
+
+        G4double energy = 0.;
+        G4double eDepGAGG = 0.;
+        G4double eDepPlastic = 0.;
+        G4double lightGAGG = 0.;
+        G4double lightPlastic = 0.;
+
+    };
+
+    /// Records the totals of every event, including the events without any
+    /// deposit, to a binary file shared by all workers, as the single-event
+    /// library of the pile-up synthesis. Records are buffered per worker and
+    /// written in blocks, so the file is complete once the workers have
+    /// ended. Every primary energy is recorded up to the event limit, so each
+    /// point of a sweep gets a library of the same size.
+
+    class EventRecorder{
+
+        public:
+
+            EventRecorder(const G4String& fileName, G4long maxEvents);
+            ~EventRecorder();
+
+            void Record(const EventRecord& record);
+            void Flush();
+
+            static constexpr char fMagic[8] = {'B', '1', 'E', 'V', 'T', 'S', '0', '1'};
+
+            // All records of a library
+            static G4bool Read(const G4String& fileName, std::vector<EventRecord>& records);
+
+        private:
+
+            static constexpr size_t fBufferSize = 4096;
+
+            G4String fFileName;
+            G4long fMaxEvents = 0;
+            std::vector<EventRecord> fBuffer;
+
+    };
+
+}
+
+#endif
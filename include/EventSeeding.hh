@@ -0,0 +1,37 @@
+/// \file B1/include/EventSeeding.hh
+/// \brief Definition of the per-event random stream seeding
+
+#ifndef B1EventSeeding_h
+#define B1EventSeeding_h 1
+
+#include "globals.hh"
+
+#include <cstdint>
+
+namespace CLHEP{
+
+    class HepRandomEngine;
+
+}
+
+namespace B1{
+
+    /// Counter-based seeding: the engine state of every event is a pure
+    /// function of (global seed, primary energy, event ID), so results do
+    /// not depend on how events are distributed over threads or processes.
+
+    std::uint64_t MixSeed(std::uint64_t key);
+
+    // Seed an engine with the 128 bits derived from a key
+    void SeedEngine(CLHEP::HepRandomEngine* engine, std::uint64_t key);
+
+    void SeedEventEngine(G4long globalSeed, G4double energy, G4long eventID);
+
+    // Offset added to the event IDs of the current run, set on the master
+    // before /run/beamOn when a run continues the statistics of an earlier one
+    void SetRunEventOffset(G4long offset);
+    G4long GetRunEventOffset();
+
+}
+
+#endif
@@ -0,0 +1,55 @@
+/// \file B1/include/ExactSum.hh
+/// \brief Definition of the B1::ExactSum class
+
+#ifndef B1ExactSum_h
+#define B1ExactSum_h 1
+
+#include "G4VAccumulable.hh"
+#include "G4Version.hh"
+#include "globals.hh"
+
+namespace B1{
+
+    /// Accumulable holding the count, sum of per-event values and sum of their
+    /// squares in fixed point. Integer addition is associative, so the merged
+    /// totals are bit-identical whatever the number of threads or the merge
+    /// order, and the sum of squared deviations from the mean is evaluated
+    /// from the integers without cancellation.
+
+    class ExactSum : public G4VAccumulable{
+
+        public:
+
+            explicit ExactSum(const G4String& name = "");
+            ~ExactSum() override = default;
+
+            void Add(G4double value);
+
+            void Merge(const G4VAccumulable& other) override;
+            void Reset() override;
+
+            // Print joined the accumulable interface in Geant4 11.3
+#if G4VERSION_NUMBER >= 1130
+            void Print(G4PrintOptions options = G4PrintOptions()) const override;
+#endif
+
+            G4long GetN() const { return fN; }
+            G4double GetSum() const;
+
+            // Sum of the squared deviations from the mean (M2)
+            G4double GetM2() const;
+
+            // Resolution of the fixed-point representation
+            static constexpr G4double fQuantum = 1.e-9;  // 1 meV in Geant4 units (MeV)
+
+        private:
+
+            G4long fN = 0;
+            __int128 fSum = 0;
+            __int128 fSum2 = 0;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,55 @@
+/// \file B1/include/FieldValidation.hh
+/// \brief Definition of the validation of the field source against the pencil beam
+
+#ifndef B1FieldValidation_h
+#define B1FieldValidation_h 1
+
+#include "RunOptions.hh"
+
+#include <filesystem>
+#include <vector>
+
+namespace B1{
+
+    /// Response per unit fluence of the field bin along +z and of the pencil
+    /// beam at one energy, in Gy cm2, with their uncertainties and the
+    /// deviations in standard deviations. A beam along +z enters the plastic
+    /// cylinder through its -z face only, so the pencil beam, uniform over
+    /// that face, times the face area is the same response; the field bin
+    /// averages directions up to its width off the axis.
+
+    struct FieldDeviation{
+
+        G4double energy = 0.;
+        G4double nEventsField = 0.;
+        G4double nEventsPencil = 0.;
+
+        G4double fieldGAGG = 0.;
+        G4double dFieldGAGG = 0.;
+        G4double pencilGAGG = 0.;
+        G4double dPencilGAGG = 0.;
+        G4double zGAGG = 0.;
+
+        G4double fieldPlastic = 0.;
+        G4double dFieldPlastic = 0.;
+        G4double pencilPlastic = 0.;
+        G4double dPencilPlastic = 0.;
+        G4double zPlastic = 0.;
+
+    };
+
+    // Deviations at the energies of both the response.txt of a field sweep
+    // and the output.txt of a pencil sweep of a plastic of the given radius
+    std::vector<FieldDeviation> CompareFieldWithPencil(const std::filesystem::path& fieldDirectory,
+        const std::filesystem::path& pencilDirectory, G4double plasticRadius);
+
+    /// Runs the field sweep of the command line and the same sweep with the
+    /// pencil beam, each in its own process and directory validation_field
+    /// and validation_pencil, then writes field_validation.txt. Returns the
+    /// process exit code.
+
+    int RunFieldValidation(int argc, char** argv, const RunOptions& options);
+
+}
+
+#endif
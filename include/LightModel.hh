@@ -0,0 +1,66 @@
+/// \file B1/include/LightModel.hh
+/// \brief Definition of the B1::LightModel class
+
+#ifndef B1LightModel_h
+#define B1LightModel_h 1
+
+#include "G4SystemOfUnits.hh"
+#include "globals.hh"
+
+#include <vector>
+
+namespace B1{
+
+    /// Scintillator response: light yield, Birks constant and a two
+    /// component exponential decay.
+
+    struct ScintillatorParameters{
+
+        G4double lightYield = 0.;       // photons per unit deposited energy
+        G4double birksConstant = 0.;    // length per unit energy
+        G4double fastTime = 0.;
+        G4double slowTime = 0.;
+        G4double fastFraction = 1.;
+
+    };
+
+    /// Parametric light output used instead of optical photon tracking.
+    /// Every step contributes its Birks-quenched light at the time of the
+    /// step; the pulse shape is obtained at the end of the event by folding
+    /// the light binned by emission start time with the decay kernel.
+
+    class LightModel{
+
+        public:
+
+            LightModel(const ScintillatorParameters& parameters);
+            ~LightModel() = default;
+
+            // Time profile binning, starting at the primary vertex time
+            static constexpr G4int fNBins = 256;
+            static constexpr G4double fBinWidth = 4. * ns;
+
+            static ScintillatorParameters GAGG();
+            static ScintillatorParameters Plastic();
+
+            // Light of one step from its energy deposit and length
+            G4double Light(G4double eDep, G4double stepLength) const;
+
+            // Bin of the emission start time, -1 outside the profile
+            G4int TimeBin(G4double time) const;
+
+            // Pulse shape from the light binned by emission start time
+            void Fold(const std::vector<G4double>& emission, std::vector<G4double>& profile) const;
+
+            const ScintillatorParameters& GetParameters() const { return fParameters; }
+
+        private:
+
+            ScintillatorParameters fParameters;
+            std::vector<G4double> fKernel;
+
+    };
+
+}
+
+#endif
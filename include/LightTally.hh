@@ -0,0 +1,49 @@
+/// \file B1/include/LightTally.hh
+/// \brief Definition of the B1::LightTally class
+
+#ifndef B1LightTally_h
+#define B1LightTally_h 1
+
+#include "G4VAccumulable.hh"
+#include "G4Version.hh"
+#include "globals.hh"
+
+#include <vector>
+
+namespace B1{
+
+    /// Accumulable of the per-event light of one volume: count, sum, sum of
+    /// the squared deviations from the mean (M2, updated as in StreamingStats)
+    /// and the summed time profile.
+
+    class LightTally : public G4VAccumulable{
+
+        public:
+
+            LightTally(const G4String& name, G4int nBins);
+            ~LightTally() override = default;
+
+            void Add(G4double light, const std::vector<G4double>& profile);
+
+            void Merge(const G4VAccumulable& other) override;
+            void Reset() override;
+#if G4VERSION_NUMBER >= 1130
+            void Print(G4PrintOptions options = G4PrintOptions()) const override;
+#endif
+
+            G4double GetSum() const { return fSum; }
+            G4double GetM2() const { return fM2; }
+            const std::vector<G4double>& GetProfile() const { return fProfile; }
+
+        private:
+
+            G4long fN = 0;
+            G4double fSum = 0.;
+            G4double fM2 = 0.;
+            std::vector<G4double> fProfile;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,38 @@
+/// \file B1/include/MemoryUsage.hh
+/// \brief Definition of the process memory accounting
+
+#ifndef B1MemoryUsage_h
+#define B1MemoryUsage_h 1
+
+#include "globals.hh"
+
+namespace B1{
+
+    /// Resident and peak resident memory of the process, from /proc/self/status
+    /// (both zero where it is not available). Threads share one address
+    /// space, so the footprint of a worker is only measurable as the slope
+    /// of the resident memory over the thread count: (RSS(N) - RSS(1)) / (N - 1)
+    /// from runs with --threads N and --threads 1.
+
+    struct MemoryUsage{
+
+        G4double resident = 0.;
+        G4double peak = 0.;
+
+    };
+
+    MemoryUsage CurrentMemoryUsage();
+
+    // Memory before the run manager initialisation, which builds the physics
+    // tables and starts and initialises the workers
+    void SetMemoryBaseline();
+
+    // Print the resident memory at a stage of the job; with worker threads,
+    // also the growth since the baseline divided by the number of threads,
+    // an upper bound of the per-worker footprint that includes the shared
+    // tables built by the master
+    void PrintMemoryUsage(const G4String& stage, G4int nThreads);
+
+}
+
+#endif
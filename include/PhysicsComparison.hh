@@ -0,0 +1,32 @@
+/// \file B1/include/PhysicsComparison.hh
+/// \brief Definition of the EM physics speed/accuracy comparison harness
+
+#ifndef B1PhysicsComparison_h
+#define B1PhysicsComparison_h 1
+
+#include "RunOptions.hh"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace B1{
+
+    /// Runs the sweep of the command line once per EM constructor of
+    /// options.comparePhysics, each in its own process and directory
+    /// physics_<name>, then writes physics_comparison.txt with the events per
+    /// second, steps per event and the dose deviations from the first
+    /// constructor of the list. Returns the process exit code.
+
+    int RunPhysicsComparison(int argc, char** argv, const RunOptions& options);
+
+    // Shell command that runs this program in the directory with the
+    // positional arguments and options of the command line, without the
+    // options named in skip; a relative cache directory is made absolute
+    std::string ChildCommand(int argc, char** argv, const std::filesystem::path& directory, const std::vector<std::string>& skip);
+
+    std::string QuoteArgument(const std::string& argument);
+
+}
+
+#endif
@@ -0,0 +1,97 @@
+/// \file B1/include/PileUp.hh
+/// \brief Definition of the B1::PileUpSynthesizer class
+
+#ifndef B1PileUp_h
+#define B1PileUp_h 1
+
+#include "EventRecorder.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "globals.hh"
+
+#include <vector>
+
+namespace B1{
+
+    /// Pulse processing of the pile-up synthesis. An event depositing at
+    /// least the threshold opens a pulse when the system is live; every event
+    /// arriving within the shaping time adds to it. The system is then dead
+    /// for the longer of the shaping and dead times from the pulse start; a
+    /// paralyzable system also restarts its dead time on every lost event.
+
+    struct PileUpSettings{
+
+        G4double shapingTime = 1. * microsecond;
+        G4double deadTime = 2. * microsecond;
+        G4bool paralyzable = false;
+        G4double threshold = 0.;
+
+        // Recorded pulses per rate, and the spectrum binning; the ranges
+        // default to twice the largest single-event value of the library
+        G4long nPulses = 1000000;
+        G4int nBins = 1024;
+        G4double maxEnergy = 0.;
+        G4double maxLight = 0.;
+
+        G4long seed = 1;
+
+    };
+
+    /// Pulse spectra at one source rate, in pulses per second per bin. Events
+    /// arriving while the system is live but depositing less than the
+    /// threshold open no pulse; they are counted apart from the lost ones.
+
+    struct PileUpSpectrum{
+
+        G4double rate = 0.;
+        G4double realTime = 0.;
+        G4long nPulses = 0;
+        G4long nPiledUp = 0;
+        G4long nLost = 0;
+        G4long nBelowThreshold = 0;
+
+        std::vector<G4double> eDepGAGG;
+        std::vector<G4double> eDepPlastic;
+        std::vector<G4double> light;
+
+    };
+
+    /// Synthesises pile-up from the recorded single events of one primary
+    /// energy, without transport: event arrivals are a Poisson process of the
+    /// given rate of simulated primaries, each arrival draws a recorded event
+    /// at random. Events without any deposit are only counted, they thin the
+    /// arrival rate of the depositing ones.
+
+    class PileUpSynthesizer{
+
+        public:
+
+            PileUpSynthesizer(const std::vector<EventRecord>& library, G4double energy, const PileUpSettings& settings);
+            ~PileUpSynthesizer() = default;
+
+            G4long GetNumberOfEvents() const { return fNEvents; }
+            G4long GetNumberOfDepositingEvents() const { return fEDepGAGG.size(); }
+            G4long GetNumberOfEventsAboveThreshold() const { return fNAboveThreshold; }
+            G4double GetEnergyBinWidth() const { return fSettings.maxEnergy / fSettings.nBins; }
+            G4double GetLightBinWidth() const { return fSettings.maxLight / fSettings.nBins; }
+
+            // Independent random stream per rate, so rates can be added or
+            // run in any order
+            PileUpSpectrum Synthesize(G4double rate) const;
+
+        private:
+
+            PileUpSettings fSettings;
+            G4long fNEvents = 0;
+            G4long fNAboveThreshold = 0;
+
+            // Depositing events, as separate arrays for the summation
+            std::vector<G4double> fEDepGAGG;
+            std::vector<G4double> fEDepPlastic;
+            std::vector<G4double> fLight;
+
+    };
+
+}
+
+#endif
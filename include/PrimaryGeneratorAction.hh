@@ -4,8 +4,14 @@
 #ifndef B1PrimaryGeneratorAction_h
 #define B1PrimaryGeneratorAction_h 1
 
+#include "RunOptions.hh"
+
+#include "G4ThreeVector.hh"
 #include "G4VUserPrimaryGeneratorAction.hh"
 
+#include <vector>
+
+class G4Box;
 class G4ParticleGun;
 class G4Event;
 class G4Tubs;
@@ -16,7 +22,7 @@ namespace B1{
 
         public:
 
-            PrimaryGeneratorAction();
+            PrimaryGeneratorAction(const RunOptions& options = RunOptions());
             ~PrimaryGeneratorAction() override;
 
             
@@ -24,10 +30,42 @@ namespace B1{
 
             const G4ParticleGun* GetParticleGun() const { return fParticleGun; }
 
+            // Radius of the sphere bounding the plastic cylinder
+            static G4double BoundingRadius(G4double plasticRadius, G4double plasticHalfZ);
+
+            // Sampling of the beam and field sources from two uniform numbers
+            // each: the direction of a field primary, uniform over the
+            // sphere, and the start point of a ray along the axis, uniform
+            // over the launch disk
+            static G4ThreeVector FieldDirection(G4double u1, G4double u2);
+            static G4ThreeVector BeamStart(const G4ThreeVector& axis, G4double boundingRadius, G4double u1, G4double u2);
+
+            // Radius of the sphere around the detector centre that contains
+            // every start point of the source: the point source distance, or
+            // the rim of the launch disk of the beam and the field
+            static G4double SourceExtent(const RunOptions& options, G4double plasticRadius, G4double plasticHalfZ);
+
+            // Geometric weight of one primary of the given source: the solid
+            // angle fraction sampled by the point source (results per emitted
+            // photon) or the beam area in cm2 for the beam and the field
+            // (results per unit fluence)
+            static G4double GeometricWeight(const RunOptions& options, G4double plasticRadius, G4double plasticHalfZ);
+
+            // Energies of a field run, set on the master before /run/beamOn
+            // and cleared after it: event i of the run has the energy of index
+            // i modulo their number and is event i / number of that energy.
+            // The gun energy applies when the list is empty.
+            static void SetFieldEnergies(const std::vector<G4double>& energies);
+            static const std::vector<G4double>& GetFieldEnergies();
+            static G4int FieldEnergyIndex(G4int eventID);
+
         private:
         
             G4ParticleGun* fParticleGun = nullptr;
             G4Tubs* fPlasticSolid = nullptr;
+            G4Box* fWorldSolid = nullptr;
+            G4int fGeometryVersion = -1;
+            RunOptions fOptions;
     };
 
 }
@@ -0,0 +1,48 @@
+/// \file B1/include/ResultCache.hh
+/// \brief Definition of the B1::ResultCache class
+
+#ifndef B1ResultCache_h
+#define B1ResultCache_h 1
+
+#include "DoseSums.hh"
+
+#include "globals.hh"
+
+#include <string>
+
+namespace B1{
+
+    /// On-disk store of the raw sums of previous runs. Entries are addressed
+    /// by a hash of the full configuration text (geometry, materials, source,
+    /// physics, cuts, Geant4 version) and the primary energy; the text itself
+    /// is kept in the entry and compared on lookup to reject hash collisions.
+    /// The layout version is part of the key, so entries written in an older
+    /// layout are never read back.
+
+    class ResultCache{
+
+        public:
+
+            ResultCache(const G4String& directory, const G4String& configuration);
+            ~ResultCache() = default;
+
+            G4bool Lookup(G4double energy, DoseSums& sums) const;
+            void Store(G4double energy, const DoseSums& sums) const;
+
+            // Version 2 stores the M2 of the deposits and the light instead of
+            // their sums of squares
+            static constexpr G4int fFormat = 2;
+
+        private:
+
+            std::string EntryKey(G4double energy) const;
+            std::string EntryPath(const std::string& key) const;
+
+            G4String fDirectory;
+            G4String fConfiguration;
+
+    };
+
+}
+
+#endif
@@ -7,8 +7,22 @@
 #include "G4UserRunAction.hh"
 
 #include "G4Accumulable.hh"
+#include "G4AutoLock.hh"
+
+#include "DirectionalTally.hh"
+#include "DoseSums.hh"
+#include "ExactSum.hh"
+#include "LightModel.hh"
+#include "LightTally.hh"
+#include "RunOptions.hh"
+#include "StatisticsTally.hh"
+
 #include "globals.hh"
 
+#include <limits>
+#include <map>
+#include <memory>
+
 class G4Run;
 
 namespace B1{
@@ -17,7 +31,7 @@ namespace B1{
 
         public:
 
-            RunAction();
+            RunAction(const RunOptions& options = RunOptions());
             ~RunAction() override = default;
 
             void BeginOfRunAction(const G4Run*) override;
@@ -26,12 +40,76 @@ namespace B1{
             void AddEDepPlastic(G4double eDep);
             void AddEDepGAGG(G4double eDep);
 
+            void AddEventStatistics(G4int eventID, G4double eDepGAGG, G4double eDepPlastic) { fStatistics.Add(eventID, eDepGAGG, eDepPlastic); }
+            void AddSteps(G4long nSteps) { fNSteps += nSteps; }
+            void AddDirectional(G4int bin, G4double eDepGAGG, G4double eDepPlastic) { fDirectional->Add(bin, eDepGAGG, eDepPlastic); }
+
+            // Steps of the last run, available on the master after the merge
+            G4long GetNumberOfSteps() const { return fNSteps.GetValue(); }
+
+            void AddLightPlastic(G4double light, const std::vector<G4double>& profile) { fLightPlastic->Add(light, profile); }
+            void AddLightGAGG(G4double light, const std::vector<G4double>& profile) { fLightGAGG->Add(light, profile); }
+
+            // Shares of an event in the sub-event mode, on the master. The
+            // master adds its own share at the end of the event and each
+            // sub-event adds its share when it is merged, with the number of
+            // sub-events of the event not yet merged, this one included. The
+            // event is scored, and its entry dropped, once the master share
+            // is in and no sub-event is left.
+            void AddMasterShare(G4int eventID, G4int remainingSubEvents, G4double eDepGAGG, G4double eDepPlastic, G4long nSteps, G4int directionBin = -1);
+            void AddSubEventShare(G4int eventID, G4int remainingSubEvents, G4double eDepGAGG, G4double eDepPlastic, G4long nSteps);
+
+            // Wall-clock time spent in an event and the steady clock time in
+            // seconds at its end
+            void AddEventTime(G4double seconds, G4double endTime);
+
+            // Thread time spent in events and the steady clock time at which
+            // the first thread finished its last event, on the master after
+            // the merge
+            G4double GetBusyTime() const { return fBusyTime.GetValue(); }
+            G4double GetFirstIdleTime() const { return fFirstIdleTime.GetValue(); }
+
+            // Raw sums of the last run, available on the master after the merge
+            const DoseSums& GetDoseSums() const { return fDoseSums; }
+
         private:
 
-            G4Accumulable<G4double> fEDepGAGG = 0.;
-            G4Accumulable<G4double> fEDep2GAGG = 0.;
-            G4Accumulable<G4double> fEDepPlastic = 0.;
-            G4Accumulable<G4double> fEDep2Plastic = 0.;
+            ExactSum fEDepGAGG{"EDepGAGG"};
+            ExactSum fEDepPlastic{"EDepPlastic"};
+            StatisticsTally fStatistics;
+
+            G4Accumulable<G4long> fNSteps = 0;
+
+            G4Accumulable<G4double> fBusyTime = 0.;
+            G4Accumulable<G4double> fFirstIdleTime{"FirstIdleTime", std::numeric_limits<G4double>::max(), G4MergeMode::kMinimum};
+            G4double fLastEventEnd = 0.;
+
+            struct EventShare{
+
+                G4double eDepGAGG = 0.;
+                G4double eDepPlastic = 0.;
+                G4long nSteps = 0;
+                G4int directionBin = -1;
+                G4bool masterDone = false;
+
+            };
+
+            // Both with the lock held
+            void ScoreEventShare(std::map<G4int, EventShare>::iterator share);
+            void ScoreEventShares();
+
+            // Events still waiting for sub-events, so at most a few per thread
+            std::map<G4int, EventShare> fEventShares;
+            G4Mutex fEventSharesMutex;
+
+            // Optional tallies, only allocated when their mode is enabled
+            std::unique_ptr<LightTally> fLightGAGG;
+            std::unique_ptr<LightTally> fLightPlastic;
+            std::unique_ptr<DirectionalTally> fDirectional;
+
+            DoseSums fDoseSums;
+
+            G4int fVerbose = 1;
 
     };
 
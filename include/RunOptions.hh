@@ -0,0 +1,108 @@
+/// \file B1/include/RunOptions.hh
+/// \brief Definition of the B1::RunOptions structure
+
+#ifndef B1RunOptions_h
+#define B1RunOptions_h 1
+
+#include "G4SystemOfUnits.hh"
+#include "globals.hh"
+
+#include <string>
+#include <vector>
+
+namespace B1{
+
+    enum class SourceMode { Pencil, Point, Beam, Field };
+
+    /// Optional batch settings, given as "--name value" pairs after the
+    /// positional geometry and energy arguments of exampleB1.
+
+    struct RunOptions{
+
+        // Messages of the simulation itself on G4cout: 0 for none, 1 for the
+        // memory usage around initialisation and at the end of every run,
+        // and the gun energy of every run
+        G4int verbose = 1;
+
+        // Per-event RNG streams derived from (seed, energy, event ID)
+        G4bool deterministicSeeding = false;
+        G4long globalSeed = 0;
+        G4long eventOffset = 0;
+
+        // Directory of the result cache, disabled when empty
+        G4String cacheDirectory;
+
+        // Wall-clock budget of each sweep in seconds, disabled when zero.
+        // The positional number of events is then the pilot size per point.
+        // Needs --seed together with --cache.
+        G4double timeBudget = 0.;
+
+        // Adaptive refinement of the energy grid, stops when no point deviates
+        // from the interpolation of its neighbours by more than this many
+        // standard deviations; disabled when zero
+        G4double adaptiveTolerance = 0.;
+
+        // Primary source: pencil beam on the plastic face, isotropic point at
+        // a distance from the detector centre, broad parallel beam, or an
+        // isotropic fluence field (broad beams from all directions, scored per
+        // direction). Point and beam are tilted by the angle from the z axis
+        // in the xz plane.
+        SourceMode sourceMode = SourceMode::Pencil;
+        G4double sourceDistance = 0.;
+        G4double sourceAngle = 0.;
+
+        // Equal solid-angle bins of cos(theta) of the field source. The field
+        // runs every energy of a sweep in one run, so it needs fixed statistics
+        // and no light model; the validation runs the sweep again with the
+        // pencil beam and compares it with the bin along +z.
+        G4int directionBins = 10;
+        G4bool validateField = false;
+
+        // Parametric scintillation light and pulse shape of both volumes
+        G4bool lightModel = false;
+
+        // EM physics constructor (see EmPhysicsChoices), per-point timing and
+        // step counts written to performance.txt, and the list of constructors
+        // to run the same sweep with and compare against the first one
+        G4String emPhysics = "opt3";
+        G4bool performanceLog = false;
+        std::vector<G4String> comparePhysics;
+
+        // Number of worker threads, run manager default when zero
+        G4int nThreads = 0;
+
+        // Binary recording of the scored steps for the replay benchmark,
+        // disabled when the file name is empty
+        G4String stepRecordFile;
+        G4long stepRecordLimit = 10000000;
+
+        // Binary recording of the totals of every event, the single-event
+        // library of the pile-up synthesis; disabled when the file name is empty.
+        // The limit applies to each primary energy of a sweep.
+        G4String eventRecordFile;
+        G4long eventRecordLimit = 10000000;
+
+        // Batches per run for the batch-means uncertainties and the
+        // convergence history, disabled when zero
+        G4int nBatches = 64;
+
+        // Sub-event parallel mode (Geant4 11.2 or later): the secondaries of
+        // events whose primary is above the threshold are tracked by the
+        // workers in sub-events of at most this many tracks, and the event
+        // totals are reassembled on the master
+        G4bool subEvents = false;
+        G4double subEventThreshold = 1. * MeV;
+        G4int subEventSize = 100;
+
+    };
+
+    RunOptions ParseRunOptions(int argc, char** argv, int first);
+
+    // Value of an on/off option, fatal for any other value
+    G4bool ParseSwitch(const std::string& name, const std::string& value);
+
+    G4String SourceModeName(SourceMode mode);
+
+}
+
+#endif
@@ -0,0 +1,164 @@
+/// \file B1/include/Simulation.hh
+/// \brief Definition of the B1::Simulation class
+
+#ifndef B1Simulation_h
+#define B1Simulation_h 1
+
+#include "DoseSums.hh"
+#include "RunOptions.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "globals.hh"
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+class G4RunManager;
+class G4VModularPhysicsList;
+
+namespace B1{
+
+    class DetectorConstruction;
+    class ResultCache;
+
+    /// Detector dimensions: plastic cylinder and the GAGG block inside it.
+
+    struct GeometryConfig{
+
+        G4double plasticDiameter = 2.1 * cm;
+        G4double plasticSizeZ = 2.0 * cm;
+        G4double gaggSizeX = 0.75 * cm;
+        G4double gaggSizeY = 0.75 * cm;
+        G4double gaggSizeZ = 2.0 * cm;
+
+    };
+
+    /// Geometry, source and run settings of a simulation. The source and the
+    /// sweep strategy are part of the run options.
+
+    struct SimulationConfig{
+
+        GeometryConfig geometry;
+        RunOptions options;
+
+        // Serial run manager for an interactive session
+        G4bool interactive = false;
+
+    };
+
+    /// Timing of one /run/beamOn, or the recorded cost of the sums of a point
+    /// served from the result cache without running.
+
+    struct RunRecord{
+
+        G4long nEvents = 0;
+        G4double wallTime = 0.;
+        G4long nSteps = 0;
+        G4double busyTime = 0.;
+        G4double idleTime = 0.;
+        G4double tailTime = 0.;
+        G4bool cached = false;
+
+    };
+
+    /// Result of one energy point: the sums with the geometric weight of the
+    /// source applied, the deposits and doses with their uncertainties, and
+    /// the runs made for the point by the call that returned it.
+
+    struct PointResult{
+
+        G4double energy = 0.;
+        DoseSums sums;
+
+        G4double eDepGAGG = 0.;
+        G4double rmsEDepGAGG = 0.;
+        G4double eDepPlastic = 0.;
+        G4double rmsEDepPlastic = 0.;
+        G4double doseGAGG = 0.;
+        G4double rmsDoseGAGG = 0.;
+        G4double dosePlastic = 0.;
+        G4double rmsDosePlastic = 0.;
+
+        std::vector<RunRecord> runs;
+
+    };
+
+    /// The B1 simulation as a library: builds the run manager, detector,
+    /// physics and actions once, and runs energy points on demand. The run
+    /// manager and the physics tables stay alive between calls, the geometry
+    /// can be changed in place. Geant4 allows one run manager per process, so
+    /// there is at most one Simulation at a time.
+
+    class Simulation{
+
+        public:
+
+            explicit Simulation(const SimulationConfig& config);
+            ~Simulation();
+
+            // Rebuild the detector with new dimensions, keeping the physics
+            void SetGeometry(const GeometryConfig& geometry);
+
+            // Bring one point up to nEvents events, reusing cached statistics
+            PointResult RunPoint(G4double energy, G4long nEvents);
+
+            // Sweep of the energies with the strategy of the run options:
+            // fixed statistics, wall-clock budget or adaptive refinement (which
+            // adds points). nEvents is the statistics per point, the pilot
+            // size of a budget or the statistics of the adaptive grid. The
+            // field source runs all energies not served by the cache in one
+            // run. Each point is also passed to the callback as soon as it is
+            // final.
+            using PointCallback = std::function<void(const PointResult&)>;
+            std::vector<PointResult> Sweep(const std::vector<G4double>& energies, G4long nEvents, const PointCallback& callback = PointCallback());
+
+            G4RunManager* GetRunManager() const { return fRunManager; }
+            const DetectorConstruction* GetDetectorConstruction() const { return fDetectorConstruction; }
+            const SimulationConfig& GetConfig() const { return fConfig; }
+            G4String GetPhysicsName() const { return fPhysicsName; }
+
+            // Scoring masses (the plastic without the GAGG) and the geometric
+            // weight of one primary
+            G4double GetGAGGMass() const;
+            G4double GetPlasticMass() const;
+            G4double GetSourceWeight() const;
+
+        private:
+
+            void ConfigureGeometry();
+            void OpenCache();
+            G4bool LookupCache(G4double energy, DoseSums& sums);
+
+            // Top up the sums of a point to the target, returns the wall-clock
+            // time of the run
+            G4double TopUp(G4double energy, DoseSums& sums, G4long targetEvents);
+            PointResult MakeResult(G4double energy, const DoseSums& sums);
+
+            // Sums of every energy from one field run, with the cost of the
+            // run split evenly over the energies run
+            std::vector<DoseSums> RunField(const std::vector<G4double>& energies, G4long nEvents);
+
+            SimulationConfig fConfig;
+
+            G4RunManager* fRunManager = nullptr;
+            DetectorConstruction* fDetectorConstruction = nullptr;
+            G4VModularPhysicsList* fPhysicsList = nullptr;
+            G4String fPhysicsName;
+
+            std::unique_ptr<ResultCache> fCache;
+
+            // Points whose sums come from the cache alone, not yet topped up
+            std::set<G4double> fCached;
+
+            // Runs made for each energy since its result was last returned
+            std::map<G4double, std::vector<RunRecord>> fRuns;
+
+    };
+
+}
+
+#endif
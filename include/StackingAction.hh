@@ -0,0 +1,35 @@
+/// \file B1/include/StackingAction.hh
+/// \brief Definition of the B1::StackingAction class
+
+#ifndef B1StackingAction_h
+#define B1StackingAction_h 1
+
+#include "G4UserStackingAction.hh"
+#include "globals.hh"
+
+namespace B1{
+
+    /// Stacking action of the sub-event parallel mode. On the master, the
+    /// secondaries of an event whose primary is above the threshold go to
+    /// sub-events, tracked by the workers; everything else stays urgent.
+
+    class StackingAction : public G4UserStackingAction{
+
+        public:
+
+            explicit StackingAction(G4double threshold);
+            ~StackingAction() override = default;
+
+            G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* track) override;
+            void PrepareNewEvent() override { fSplit = false; }
+
+        private:
+
+            G4double fThreshold = 0.;
+            G4bool fSplit = false;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,64 @@
+/// \file B1/include/StatisticsTally.hh
+/// \brief Definition of the B1::StatisticsTally class
+
+#ifndef B1StatisticsTally_h
+#define B1StatisticsTally_h 1
+
+#include "StreamingStats.hh"
+
+#include "G4VAccumulable.hh"
+#include "G4Version.hh"
+#include "globals.hh"
+
+#include <vector>
+
+namespace B1{
+
+    /// Accumulable of the per-event deposits of both volumes as streaming
+    /// moments, and as batch sums for the batch-means uncertainty and the
+    /// convergence history. A run is cut into a fixed number of batches of
+    /// consecutive event IDs; the batch sums are kept in the fixed point of
+    /// ExactSum, so they merge bit-identically whatever the number of threads.
+
+    class StatisticsTally : public G4VAccumulable{
+
+        public:
+
+            StatisticsTally(const G4String& name, G4int nBatches);
+            ~StatisticsTally() override = default;
+
+            // Per batch: events, sum of the GAGG and of the plastic deposits
+            static constexpr G4int fNValues = 3;
+
+            // Number of events of the coming run, which sets the batch length
+            void SetRunLength(G4long nEvents) { fRunLength = nEvents; }
+
+            void Add(G4int eventID, G4double eDepGAGG, G4double eDepPlastic);
+
+            void Merge(const G4VAccumulable& other) override;
+            void Reset() override;
+#if G4VERSION_NUMBER >= 1130
+            void Print(G4PrintOptions options = G4PrintOptions()) const override;
+#endif
+
+            const StreamingStats& GetGAGG() const { return fGAGG; }
+            const StreamingStats& GetPlastic() const { return fPlastic; }
+
+            // Batch sums flattened as above, empty batches left out
+            std::vector<G4double> GetBatches() const;
+
+        private:
+
+            StreamingStats fGAGG;
+            StreamingStats fPlastic;
+
+            G4long fRunLength = 0;
+            std::vector<G4long> fBatchEvents;
+            std::vector<__int128> fBatchGAGG;
+            std::vector<__int128> fBatchPlastic;
+
+    };
+
+}
+
+#endif
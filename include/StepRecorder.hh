@@ -0,0 +1,64 @@
+/// \file B1/include/StepRecorder.hh
+/// \brief Definition of the B1::StepRecorder class
+
+#ifndef B1StepRecorder_h
+#define B1StepRecorder_h 1
+
+#include "globals.hh"
+
+#include <cstdint>
+#include <vector>
+
+namespace B1{
+
+    /// One recorded step, as seen by the scoring code. Volume is 0 outside
+    /// the scoring volumes, 1 for the plastic and 2 for the GAGG.
+
+    struct StepRecord{
+
+        std::int32_t volume = 0;
+        std::int32_t pdgCode = 0;
+        std::int32_t trackID = 0;
+        std::int32_t parentID = 0;
+        G4double eDep = 0.;
+        G4double x = 0.;
+        G4double y = 0.;
+        G4double z = 0.;
+        G4double stepLength = 0.;
+        G4double time = 0.;
+
+    };
+
+    /// Records the steps of each worker to a binary file shared by all
+    /// workers. Steps are buffered per event and written as one block, so
+    /// events stay contiguous: a uint32 step count followed by the records.
+    /// Recording stops at the first event that does not fit in the total
+    /// step limit, so large events are not selected against.
+
+    class StepRecorder{
+
+        public:
+
+            StepRecorder(const G4String& fileName, G4long maxSteps);
+            ~StepRecorder() = default;
+
+            void Record(const StepRecord& record) { if (!fFull) fEventSteps.push_back(record); }
+            void EndOfEvent();
+
+            static constexpr char fMagic[8] = {'B', '1', 'S', 'T', 'E', 'P', 'S', '1'};
+
+            // Whole events of a recording, for replay
+            static G4bool Read(const G4String& fileName, std::vector<StepRecord>& steps, std::vector<std::uint32_t>& eventSizes);
+
+        private:
+
+            G4String fFileName;
+            G4long fMaxSteps = 0;
+            G4bool fFull = false;
+            std::vector<StepRecord> fEventSteps;
+
+    };
+
+}
+
+#endif
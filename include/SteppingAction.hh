@@ -5,6 +5,7 @@
 #define B1SteppingAction_h 1
 
 #include "G4UserSteppingAction.hh"
+#include "globals.hh"
 
 class G4LogicalVolume;
 class G4Step;
@@ -12,6 +13,7 @@ class G4Step;
 namespace B1{
 
     class EventAction;
+    class StepRecorder;
 
     class SteppingAction : public G4UserSteppingAction{
 
@@ -22,11 +24,18 @@ namespace B1{
 
             void UserSteppingAction(const G4Step*) override;
 
+            // Scoring of one step, also driven directly by the step replay benchmark
+            void Score(const G4LogicalVolume* volume, G4double eDep, G4double stepLength, G4double time);
+            void SetScoringVolumes(G4LogicalVolume* plastic, G4LogicalVolume* gagg);
+
         private:
 
             EventAction* fEventAction = nullptr;
             G4LogicalVolume* fScoringVolumeGAGG = nullptr;
             G4LogicalVolume* fScoringVolumePlastic = nullptr;
+            G4int fGeometryVersion = -1;
+            G4bool fLightEnabled = false;
+            StepRecorder* fStepRecorder = nullptr;
 
     };
 
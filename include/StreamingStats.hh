@@ -0,0 +1,45 @@
+/// \file B1/include/StreamingStats.hh
+/// \brief Definition of the B1::StreamingStats structure
+
+#ifndef B1StreamingStats_h
+#define B1StreamingStats_h 1
+
+#include "globals.hh"
+
+namespace B1{
+
+    /// Streaming moments of a per-event quantity: count, mean and the central
+    /// moment sums M2, M3 and M4, updated one value at a time (Welford) and
+    /// combined pairwise (Chan et al., Pebay), so the variance never comes
+    /// from the difference of two large sums.
+
+    struct StreamingStats{
+
+        G4long n = 0;
+        G4double mean = 0.;
+        G4double m2 = 0.;
+        G4double m3 = 0.;
+        G4double m4 = 0.;
+
+        void Add(G4double value);
+        void Merge(const StreamingStats& other);
+
+        // Apply a constant per-event weight
+        void Scale(G4double weight);
+
+        G4double Variance() const { return n > 1 ? m2 / (n - 1) : 0.; }
+        G4double StandardError() const;
+
+        // Relative variance of the variance of the mean (the MCNP VOV),
+        // sum (x - mean)^4 / (sum (x - mean)^2)^2 - 1/n; below 0.1 for a
+        // well converged tally
+        G4double VarianceOfVariance() const;
+
+        G4double Skewness() const;
+        G4double ExcessKurtosis() const;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,39 @@
+/// \file B1/include/SubEventDeposits.hh
+/// \brief Definition of the B1::SubEventDeposits class
+
+#ifndef B1SubEventDeposits_h
+#define B1SubEventDeposits_h 1
+
+#include "G4VUserEventInformation.hh"
+#include "globals.hh"
+
+namespace B1{
+
+    /// Deposits scored by a worker in one sub-event, attached to the
+    /// sub-event so the master can add them to the totals of its event.
+
+    class SubEventDeposits : public G4VUserEventInformation{
+
+        public:
+
+            SubEventDeposits(G4double eDepGAGG, G4double eDepPlastic, G4long nSteps)
+                : fEDepGAGG(eDepGAGG), fEDepPlastic(eDepPlastic), fNSteps(nSteps) {}
+            ~SubEventDeposits() override = default;
+
+            void Print() const override;
+
+            G4double GetEDepGAGG() const { return fEDepGAGG; }
+            G4double GetEDepPlastic() const { return fEDepPlastic; }
+            G4long GetNumberOfSteps() const { return fNSteps; }
+
+        private:
+
+            G4double fEDepGAGG = 0.;
+            G4double fEDepPlastic = 0.;
+            G4long fNSteps = 0;
+
+    };
+
+}
+
+#endif
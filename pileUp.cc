@@ -0,0 +1,173 @@
+/// \file pileUp.cc
+/// \brief Pile-up synthesis from a recorded single-event library
+///
+/// Usage: pileUp <library> <energy/MeV> --rates r1,r2,... [--shaping ns]
+///        [--dead-time ns] [--paralyzable on|off] [--threshold keV]
+///        [--pulses N] [--bins N] [--max-energy MeV] [--max-light photons]
+///        [--seed S]
+/// The library is written by exampleB1 with --record-events. Rates are
+/// rates of simulated primaries per second, i.e. the physical rate on the
+/// source surface times the geometric weight of the source. The pulse
+/// spectra of every rate are written to pileup_spectra.txt and the
+/// throughput to pileup_summary.txt, without any transport.
+
+#include "EventRecorder.hh"
+#include "PileUp.hh"
+#include "RunOptions.hh"
+
+#include "G4Exception.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace B1;
+
+int main(int argc, char** argv){
+
+    if (argc < 3) {
+
+        G4cerr << "Usage: " << argv[0] << " <library> <energy/MeV> --rates r1,r2,... [--shaping ns] [--dead-time ns]"
+        << " [--paralyzable on|off] [--threshold keV] [--pulses N] [--bins N] [--max-energy MeV] [--max-light photons] [--seed S]" << G4endl;
+        return 1;
+
+    }
+
+    std::vector<EventRecord> library;
+    if (!EventRecorder::Read(argv[1], library) || library.empty()) {
+
+        G4cerr << "No recorded events in " << argv[1] << G4endl;
+        return 1;
+
+    }
+
+    G4double energy = std::stod(argv[2]) * MeV;
+    PileUpSettings settings;
+    std::vector<G4double> rates;
+
+    for (int i = 3; i < argc; ++i) {
+
+        std::string name = argv[i];
+        if (i + 1 >= argc) {
+
+            G4Exception("pileUp", "B1PileUp002", FatalException,
+                ("Missing value for option " + name).c_str());
+
+        }
+        std::string value = argv[++i];
+
+        if (name == "--rates") {
+
+            std::stringstream list(value);
+            std::string item;
+            while (std::getline(list, item, ',')) rates.push_back(std::stod(item) / second);
+
+        }
+        else if (name == "--shaping") {
+
+            settings.shapingTime = std::stod(value) * ns;
+
+        }
+        else if (name == "--dead-time") {
+
+            settings.deadTime = std::stod(value) * ns;
+
+        }
+        else if (name == "--paralyzable") {
+
+            settings.paralyzable = ParseSwitch(name, value);
+
+        }
+        else if (name == "--threshold") {
+
+            settings.threshold = std::stod(value) * keV;
+
+        }
+        else if (name == "--pulses") {
+
+            settings.nPulses = std::stol(value);
+
+        }
+        else if (name == "--bins") {
+
+            settings.nBins = std::stoi(value);
+
+        }
+        else if (name == "--max-energy") {
+
+            settings.maxEnergy = std::stod(value) * MeV;
+
+        }
+        else if (name == "--max-light") {
+
+            settings.maxLight = std::stod(value);
+
+        }
+        else if (name == "--seed") {
+
+            settings.seed = std::stol(value);
+
+        }
+        else {
+
+            G4Exception("pileUp", "B1PileUp003", FatalException,
+                ("Unknown option " + name).c_str());
+
+        }
+
+    }
+
+    if (rates.empty() || settings.nPulses <= 0 || settings.nBins <= 0) {
+
+        G4Exception("pileUp", "B1PileUp004", FatalException,
+            "At least one rate, one pulse and one bin are needed");
+
+    }
+
+    PileUpSynthesizer synthesizer(library, energy, settings);
+    G4cout
+    << "Library of " << synthesizer.GetNumberOfEvents() << " events at " << energy / MeV << " MeV, "
+    << synthesizer.GetNumberOfDepositingEvents() << " with a deposit, "
+    << synthesizer.GetNumberOfEventsAboveThreshold() << " above the threshold"
+    << G4endl;
+
+    std::ofstream spectraFile("pileup_spectra.txt");
+    spectraFile << "# Rate(1/s)\tBin\tE_low(MeV)\tGAGG(1/s)\tPlastic(1/s)\tLight_low(photons)\tLight(1/s)\n";
+    std::ofstream summaryFile("pileup_summary.txt");
+    summaryFile << "# Rate(1/s)\tDepositingRate(1/s)\tRecordedRate(1/s)\tPileUpFraction\tLost\tBelowThreshold\tLiveFraction\n";
+
+    for (G4double rate : rates) {
+
+        auto start = std::chrono::steady_clock::now();
+        PileUpSpectrum spectrum = synthesizer.Synthesize(rate);
+        std::chrono::duration<G4double> elapsed = std::chrono::steady_clock::now() - start;
+
+        for (G4int bin = 0; bin < settings.nBins; ++bin) {
+
+            spectraFile << rate * second << "\t" << bin << "\t" << bin * synthesizer.GetEnergyBinWidth() / MeV
+                << "\t" << spectrum.eDepGAGG[bin] << "\t" << spectrum.eDepPlastic[bin]
+                << "\t" << bin * synthesizer.GetLightBinWidth() << "\t" << (spectrum.light.empty() ? 0. : spectrum.light[bin]) << "\n";
+
+        }
+
+        // Depositing events arriving in the real time, recorded or not
+        G4double depositingRate = rate * synthesizer.GetNumberOfDepositingEvents() / synthesizer.GetNumberOfEvents();
+        G4double recordedRate = (spectrum.realTime > 0.) ? spectrum.nPulses / spectrum.realTime : 0.;
+        G4double pileUpFraction = (spectrum.nPulses > 0) ? static_cast<G4double>(spectrum.nPiledUp) / spectrum.nPulses : 0.;
+        G4double liveFraction = (depositingRate > 0.) ? 1. - spectrum.nLost / (depositingRate * spectrum.realTime) : 1.;
+        summaryFile << rate * second << "\t" << depositingRate * second << "\t" << recordedRate * second
+            << "\t" << pileUpFraction << "\t" << spectrum.nLost << "\t" << spectrum.nBelowThreshold << "\t" << liveFraction << "\n";
+
+        G4cout
+        << "Rate " << rate * second << "/s: " << spectrum.nPulses << " pulses in " << spectrum.realTime / second << " s, "
+        << 100. * pileUpFraction << "% piled up, " << spectrum.nLost << " events lost, " << spectrum.nBelowThreshold
+        << " below the threshold; synthesised in " << elapsed.count() << " s"
+        << G4endl;
+
+    }
+
+    return 0;
+
+}
@@ -32,32 +32,66 @@
 #include "EventAction.hh"
 #include "PrimaryGeneratorAction.hh"
 #include "RunAction.hh"
+#include "StackingAction.hh"
 #include "SteppingAction.hh"
 
+#include "G4Threading.hh"
+
 namespace B1
 {
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+ActionInitialization::ActionInitialization(const RunOptions& options) : fOptions(options)
+{
+  if (fOptions.lightModel) {
+    fLightModelPlastic = std::make_unique<const LightModel>(LightModel::Plastic());
+    fLightModelGAGG = std::make_unique<const LightModel>(LightModel::GAGG());
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 void ActionInitialization::BuildForMaster() const
 {
-  auto runAction = new RunAction;
-  SetUserAction(runAction);
+  BuildMasterRunAction();
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 void ActionInitialization::Build() const
 {
-  SetUserAction(new PrimaryGeneratorAction);
+  SetUserAction(new PrimaryGeneratorAction(fOptions));
 
-  auto runAction = new RunAction;
-  SetUserAction(runAction);
+  // In the sequential and sub-event modes the master also tracks events,
+  // with the run action that holds the merged accumulables
+  RunAction* runAction = nullptr;
+  if (G4Threading::IsMasterThread()) {
+    runAction = BuildMasterRunAction();
+  }
+  else {
+    runAction = new RunAction(fOptions);
+    SetUserAction(runAction);
+  }
 
-  auto eventAction = new EventAction(runAction);
+  auto eventAction = new EventAction(runAction, fOptions, fLightModelPlastic.get(), fLightModelGAGG.get());
   SetUserAction(eventAction);
 
   SetUserAction(new SteppingAction(eventAction));
+
+  if (fOptions.subEvents) SetUserAction(new StackingAction(fOptions.subEventThreshold));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+RunAction* ActionInitialization::BuildMasterRunAction() const
+{
+  // Built by whichever of BuildForMaster and Build comes first
+  if (!fMasterRunAction) {
+    fMasterRunAction = new RunAction(fOptions);
+    SetUserAction(fMasterRunAction);
+  }
+  return fMasterRunAction;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
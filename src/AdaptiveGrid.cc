@@ -0,0 +1,60 @@
+/// \file B1/src/AdaptiveGrid.cc
+/// \brief Implementation of the adaptive energy-grid refinement
+
+#include "AdaptiveGrid.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace B1{
+
+    namespace {
+
+        G4double Significance(G4double w, G4double left, G4double rmsLeft, G4double value, G4double rmsValue, G4double right, G4double rmsRight){
+
+            if (left > 0. && value > 0. && right > 0.) {
+
+                // Log-log interpolation, relative uncertainties
+                G4double interpolated = (1. - w) * std::log(left) + w * std::log(right);
+                G4double sigma2 = std::pow(rmsValue / value, 2)
+                                + std::pow((1. - w) * rmsLeft / left, 2)
+                                + std::pow(w * rmsRight / right, 2);
+                if (sigma2 <= 0.) return 0.;
+                return std::abs(std::log(value) - interpolated) / std::sqrt(sigma2);
+
+            }
+
+            // Zero deposits somewhere: linear interpolation in log energy
+            G4double interpolated = (1. - w) * left + w * right;
+            G4double sigma2 = rmsValue * rmsValue
+                            + std::pow((1. - w) * rmsLeft, 2)
+                            + std::pow(w * rmsRight, 2);
+            if (sigma2 <= 0.) return 0.;
+            return std::abs(value - interpolated) / std::sqrt(sigma2);
+
+        }
+
+    }
+
+    G4double InterpolationSignificance(const GridPoint& left, const GridPoint& point, const GridPoint& right){
+
+        G4double w = (point.logEnergy - left.logEnergy) / (right.logEnergy - left.logEnergy);
+
+        // Compare mean deposits per event, the points may differ in statistics
+        auto mean = [](G4double sum, const DoseSums& sums) { return sums.nEvents > 0 ? sum / sums.nEvents : 0.; };
+
+        G4double gagg = Significance(w,
+            mean(left.sums.eDepGAGG, left.sums), mean(left.sums.RmsEDepGAGG(), left.sums),
+            mean(point.sums.eDepGAGG, point.sums), mean(point.sums.RmsEDepGAGG(), point.sums),
+            mean(right.sums.eDepGAGG, right.sums), mean(right.sums.RmsEDepGAGG(), right.sums));
+
+        G4double plastic = Significance(w,
+            mean(left.sums.eDepPlastic, left.sums), mean(left.sums.RmsEDepPlastic(), left.sums),
+            mean(point.sums.eDepPlastic, point.sums), mean(point.sums.RmsEDepPlastic(), point.sums),
+            mean(right.sums.eDepPlastic, right.sums), mean(right.sums.RmsEDepPlastic(), right.sums));
+
+        return std::max(gagg, plastic);
+
+    }
+
+}
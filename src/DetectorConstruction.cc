@@ -9,8 +9,17 @@
 #include "G4NistManager.hh"
 #include "G4PVPlacement.hh"
 
+#include <algorithm>
+#include <atomic>
+
 namespace B1{
 
+    namespace {
+
+        std::atomic<G4int> geometryVersion{0};
+
+    }
+
     G4VPhysicalVolume* DetectorConstruction::Construct() {
      
         // Get nist material manager
@@ -57,8 +66,8 @@ namespace B1{
         // World parameters 
         // **********************
     
-        G4double worldSizeXY = 1.2 * plasticDiameter;
-        G4double worldSizeZ = 1.2 * plasticSizeZ;
+        G4double worldSizeXY = std::max(1.2 * plasticDiameter, 2.2 * sourceExtent);
+        G4double worldSizeZ = std::max(1.2 * plasticSizeZ, 2.2 * sourceExtent);
         G4Material* worldMat = nist->FindOrBuildMaterial("G4_AIR");
 
         // **********************
@@ -149,6 +158,7 @@ namespace B1{
 
         fScoringVolumePlastic = logicPlastic;
         fScoringVolumeGAGG = logicGAGG;
+        ++geometryVersion;
 
         // **********************
         // Always return the physical World
@@ -169,4 +179,10 @@ namespace B1{
         gaggSizeZ = sizeZ;
     }
 
-}
\ No newline at end of file
+    G4int DetectorConstruction::GetGeometryVersion(){
+
+        return geometryVersion.load(std::memory_order_relaxed);
+
+    }
+
+}
@@ -0,0 +1,116 @@
+/// \file B1/src/DirectionalTally.cc
+/// \brief Implementation of the B1::DirectionalTally class
+
+#include "DirectionalTally.hh"
+
+#include <algorithm>
+
+namespace B1{
+
+    namespace {
+
+        // Chan merge of a sum and M2 over n values with those over otherN values
+        void MergeValues(G4double n, G4double otherN, G4double otherSum, G4double otherM2, G4double& sum, G4double& m2){
+
+            if (n > 0. && otherN > 0.) {
+
+                G4double delta = otherSum / otherN - sum / n;
+                m2 += delta * delta * n * otherN / (n + otherN);
+
+            }
+            sum += otherSum;
+            m2 += otherM2;
+
+        }
+
+    }
+
+    DirectionalTally::DirectionalTally(const G4String& name, G4int nDirectionBins)
+        : G4VAccumulable(name), fNDirectionBins(std::max(nDirectionBins, 1)) {
+
+        SetNumberOfEnergies(1);
+
+    }
+
+    G4int DirectionalTally::Bin(const G4ThreeVector& direction, G4int nDirectionBins){
+
+        G4int bin = static_cast<G4int>(0.5 * (direction.cosTheta() + 1.) * nDirectionBins);
+        return std::clamp(bin, 0, nDirectionBins - 1);
+
+    }
+
+    void DirectionalTally::SetNumberOfEnergies(G4int nEnergies){
+
+        size_t nBins = static_cast<size_t>(std::max(nEnergies, 1)) * fNDirectionBins;
+        fGAGG.assign(nBins, ExactSum());
+        fPlastic.assign(nBins, ExactSum());
+
+    }
+
+    void DirectionalTally::Add(G4int bin, G4double eDepGAGG, G4double eDepPlastic){
+
+        fGAGG[bin].Add(eDepGAGG);
+        fPlastic[bin].Add(eDepPlastic);
+
+    }
+
+    void DirectionalTally::Merge(const G4VAccumulable& other){
+
+        const auto& otherTally = static_cast<const DirectionalTally&>(other);
+        for (size_t bin = 0; bin < fGAGG.size(); ++bin) {
+
+            fGAGG[bin].Merge(otherTally.fGAGG[bin]);
+            fPlastic[bin].Merge(otherTally.fPlastic[bin]);
+
+        }
+
+    }
+
+    void DirectionalTally::Reset(){
+
+        for (auto& sum : fGAGG) sum.Reset();
+        for (auto& sum : fPlastic) sum.Reset();
+
+    }
+
+#if G4VERSION_NUMBER >= 1130
+    void DirectionalTally::Print(G4PrintOptions) const{
+
+        G4cout << GetName() << ":";
+        for (const auto& sum : fGAGG) G4cout << " " << sum.GetN();
+        G4cout << " events per bin" << G4endl;
+
+    }
+#endif
+
+    std::vector<G4double> DirectionalTally::GetValues() const{
+
+        std::vector<G4double> values;
+        values.reserve(fGAGG.size() * fNValues);
+        for (size_t bin = 0; bin < fGAGG.size(); ++bin) {
+
+            values.insert(values.end(), {
+                static_cast<G4double>(fGAGG[bin].GetN()),
+                fGAGG[bin].GetSum(), fGAGG[bin].GetM2(),
+                fPlastic[bin].GetSum(), fPlastic[bin].GetM2()
+            });
+
+        }
+        return values;
+
+    }
+
+    void DirectionalTally::MergeBins(std::vector<G4double>& values, const std::vector<G4double>& other){
+
+        if (values.size() < other.size()) values.resize(other.size(), 0.);
+        for (size_t i = 0; i + fNValues <= other.size(); i += fNValues) {
+
+            MergeValues(values[i], other[i], other[i + 1], other[i + 2], values[i + 1], values[i + 2]);
+            MergeValues(values[i], other[i], other[i + 3], other[i + 4], values[i + 3], values[i + 4]);
+            values[i] += other[i];
+
+        }
+
+    }
+
+}
@@ -0,0 +1,140 @@
+/// \file B1/src/DoseSums.cc
+/// \brief Implementation of the B1::DoseSums structure
+
+#include "DoseSums.hh"
+#include "DirectionalTally.hh"
+#include "StatisticsTally.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace B1{
+
+    namespace {
+
+        void MergeProfile(std::vector<G4double>& profile, const std::vector<G4double>& other){
+
+            if (profile.size() < other.size()) profile.resize(other.size(), 0.);
+            for (size_t i = 0; i < other.size(); ++i) profile[i] += other[i];
+
+        }
+
+        // M2 of the union of two sets of n and otherN values (Chan et al.)
+        void MergeM2(G4double& m2, G4double sum, G4long n, G4double otherM2, G4double otherSum, G4long otherN){
+
+            if (n > 0 && otherN > 0) {
+
+                G4double delta = otherSum / otherN - sum / n;
+                m2 += delta * delta * n * otherN / (n + otherN);
+
+            }
+            m2 += otherM2;
+
+        }
+
+    }
+
+    void DoseSums::Merge(const DoseSums& other){
+
+        MergeM2(eDepM2GAGG, eDepGAGG, nEvents, other.eDepM2GAGG, other.eDepGAGG, other.nEvents);
+        MergeM2(eDepM2Plastic, eDepPlastic, nEvents, other.eDepM2Plastic, other.eDepPlastic, other.nEvents);
+        MergeM2(lightM2GAGG, lightGAGG, nEvents, other.lightM2GAGG, other.lightGAGG, other.nEvents);
+        MergeM2(lightM2Plastic, lightPlastic, nEvents, other.lightM2Plastic, other.lightPlastic, other.nEvents);
+
+        nEvents += other.nEvents;
+        eDepGAGG += other.eDepGAGG;
+        eDepPlastic += other.eDepPlastic;
+
+        lightGAGG += other.lightGAGG;
+        lightPlastic += other.lightPlastic;
+        MergeProfile(profileGAGG, other.profileGAGG);
+        MergeProfile(profilePlastic, other.profilePlastic);
+        DirectionalTally::MergeBins(directional, other.directional);
+
+        // Later runs continue the batch sequence
+        statsGAGG.Merge(other.statsGAGG);
+        statsPlastic.Merge(other.statsPlastic);
+        batches.insert(batches.end(), other.batches.begin(), other.batches.end());
+
+        seconds += other.seconds;
+        nSteps += other.nSteps;
+
+    }
+
+    void DoseSums::Scale(G4double weight){
+
+        eDepGAGG *= weight;
+        eDepM2GAGG *= weight * weight;
+        eDepPlastic *= weight;
+        eDepM2Plastic *= weight * weight;
+
+        lightGAGG *= weight;
+        lightM2GAGG *= weight * weight;
+        lightPlastic *= weight;
+        lightM2Plastic *= weight * weight;
+        for (auto& value : profileGAGG) value *= weight;
+        for (auto& value : profilePlastic) value *= weight;
+
+        // Per direction: events, then sum and M2 for each volume
+        for (size_t i = 0; i + DirectionalTally::fNValues <= directional.size(); i += DirectionalTally::fNValues) {
+
+            directional[i + 1] *= weight;
+            directional[i + 2] *= weight * weight;
+            directional[i + 3] *= weight;
+            directional[i + 4] *= weight * weight;
+
+        }
+
+        statsGAGG.Scale(weight);
+        statsPlastic.Scale(weight);
+        for (size_t i = 0; i < batches.size(); i += StatisticsTally::fNValues) {
+
+            batches[i + 1] *= weight;
+            batches[i + 2] *= weight;
+
+        }
+
+    }
+
+    G4double DoseSums::Rms(G4double m2) const{
+
+        if (nEvents == 0 || m2 <= 0.) return 0.;
+        return std::sqrt(m2);
+
+    }
+
+    size_t DoseSums::NumberOfBatches() const{
+
+        return batches.size() / StatisticsTally::fNValues;
+
+    }
+
+    G4double DoseSums::BatchError(size_t value, size_t nBatches) const{
+
+        nBatches = std::min(nBatches, NumberOfBatches());
+        if (nBatches < 2) return 0.;
+
+        G4double n = 0.;
+        G4double sum = 0.;
+        for (size_t i = 0; i < nBatches; ++i) {
+
+            n += batches[i * StatisticsTally::fNValues];
+            sum += batches[i * StatisticsTally::fNValues + value];
+
+        }
+        G4double mean = sum / n;
+
+        // Batches of unequal length weigh by their number of events
+        G4double deviation2 = 0.;
+        for (size_t i = 0; i < nBatches; ++i) {
+
+            G4double deviation = batches[i * StatisticsTally::fNValues + value] - batches[i * StatisticsTally::fNValues] * mean;
+            deviation2 += deviation * deviation;
+
+        }
+
+        return std::sqrt(nBatches / (nBatches - 1.) * deviation2) / n;
+
+    }
+
+}
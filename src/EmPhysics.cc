@@ -0,0 +1,75 @@
+/// \file B1/src/EmPhysics.cc
+/// \brief Implementation of the selectable electromagnetic physics constructors
+
+#include "EmPhysics.hh"
+
+#include "G4EmLivermorePhysics.hh"
+#include "G4EmLowEPPhysics.hh"
+#include "G4EmPenelopePhysics.hh"
+#include "G4EmStandardPhysics.hh"
+#include "G4EmStandardPhysics_option1.hh"
+#include "G4EmStandardPhysics_option2.hh"
+#include "G4EmStandardPhysics_option3.hh"
+#include "G4EmStandardPhysics_option4.hh"
+#include "G4Exception.hh"
+
+namespace B1{
+
+    namespace {
+
+        struct EmPhysicsEntry{
+
+            const char* choice;
+            const char* className;
+            G4VPhysicsConstructor* (*create)();
+
+        };
+
+        const EmPhysicsEntry emPhysicsTable[] = {
+            {"opt0", "G4EmStandardPhysics", []() -> G4VPhysicsConstructor* { return new G4EmStandardPhysics; }},
+            {"opt1", "G4EmStandardPhysics_option1", []() -> G4VPhysicsConstructor* { return new G4EmStandardPhysics_option1; }},
+            {"opt2", "G4EmStandardPhysics_option2", []() -> G4VPhysicsConstructor* { return new G4EmStandardPhysics_option2; }},
+            {"opt3", "G4EmStandardPhysics_option3", []() -> G4VPhysicsConstructor* { return new G4EmStandardPhysics_option3; }},
+            {"opt4", "G4EmStandardPhysics_option4", []() -> G4VPhysicsConstructor* { return new G4EmStandardPhysics_option4; }},
+            {"livermore", "G4EmLivermorePhysics", []() -> G4VPhysicsConstructor* { return new G4EmLivermorePhysics; }},
+            {"penelope", "G4EmPenelopePhysics", []() -> G4VPhysicsConstructor* { return new G4EmPenelopePhysics; }},
+            {"lowep", "G4EmLowEPPhysics", []() -> G4VPhysicsConstructor* { return new G4EmLowEPPhysics; }}
+        };
+
+        const EmPhysicsEntry& FindEntry(const G4String& choice){
+
+            for (const auto& entry : emPhysicsTable) {
+
+                if (choice == entry.choice) return entry;
+
+            }
+
+            G4Exception("B1::CreateEmPhysics", "B1Physics001", FatalException,
+                ("Unknown EM physics " + choice).c_str());
+            return emPhysicsTable[3];
+
+        }
+
+    }
+
+    std::vector<G4String> EmPhysicsChoices(){
+
+        std::vector<G4String> choices;
+        for (const auto& entry : emPhysicsTable) choices.push_back(entry.choice);
+        return choices;
+
+    }
+
+    G4VPhysicsConstructor* CreateEmPhysics(const G4String& choice){
+
+        return FindEntry(choice).create();
+
+    }
+
+    G4String EmPhysicsClassName(const G4String& choice){
+
+        return FindEntry(choice).className;
+
+    }
+
+}
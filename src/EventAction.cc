@@ -4,16 +4,61 @@
 #include "EventAction.hh"
 #include "RunAction.hh"
 
+#include "DirectionalTally.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "SubEventDeposits.hh"
+
 #include "G4Event.hh"
+#include "G4EventManager.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4Threading.hh"
+
+#include <algorithm>
 
 namespace B1{
     
-    EventAction::EventAction(RunAction* runAction) : fRunAction(runAction) {}
+    EventAction::EventAction(RunAction* runAction, const RunOptions& options,
+        const LightModel* lightModelPlastic, const LightModel* lightModelGAGG)
+        : fRunAction(runAction), fLightModelPlastic(lightModelPlastic), fLightModelGAGG(lightModelGAGG),
+          fDirectional(options.sourceMode == SourceMode::Field), fDirectionBins(options.directionBins), fSubEvents(options.subEvents) {
+
+        if (!options.stepRecordFile.empty()) {
+
+            fStepRecorder = std::make_unique<StepRecorder>(options.stepRecordFile, options.stepRecordLimit);
+
+        }
+
+        if (!options.eventRecordFile.empty()) {
+
+            fEventRecorder = std::make_unique<EventRecorder>(options.eventRecordFile, options.eventRecordLimit);
+
+        }
+
+        if (IsLightEnabled()) {
+
+            fEmissionPlastic.assign(LightModel::fNBins, 0.);
+            fEmissionGAGG.assign(LightModel::fNBins, 0.);
+
+        }
+
+    }
     
     void EventAction::BeginOfEventAction(const G4Event*){
 
         fEDepEventPlastic = 0.;
         fEDepEventGAGG = 0.;
+        fNStepsEvent = 0;
+        if (fEventTiming) fEventStart = std::chrono::steady_clock::now();
+
+        if (IsLightEnabled()) {
+
+            fLightEventPlastic = 0.;
+            fLightEventGAGG = 0.;
+            std::fill(fEmissionPlastic.begin(), fEmissionPlastic.end(), 0.);
+            std::fill(fEmissionGAGG.begin(), fEmissionGAGG.end(), 0.);
+
+        }
 
     }
 
@@ -26,8 +71,108 @@ namespace B1{
 
         }
 
-        fRunAction->AddEDepPlastic(fEDepEventPlastic);
-        fRunAction->AddEDepGAGG(fEDepEventGAGG);
+        G4int directionBin = -1;
+        if (fDirectional && event->GetPrimaryVertex()) {
+
+            // Direction bins of the energy of the event within the run
+            G4int directionBinOfEnergy = DirectionalTally::Bin(event->GetPrimaryVertex()->GetPrimary()->GetMomentumDirection(), fDirectionBins);
+            directionBin = PrimaryGeneratorAction::FieldEnergyIndex(eventID) * fDirectionBins + directionBinOfEnergy;
+
+        }
+
+        // The sub-event mode is rejected by the option parser before 11.2
+#if G4VERSION_NUMBER >= 1120
+        if (fSubEvents) {
+
+            // A worker only tracked a sub-event: its deposits travel with it to
+            // the master, which adds them to the share of its own event
+            if (!G4Threading::IsMasterThread()) {
+
+                G4EventManager::GetEventManager()->SetUserInformation(new SubEventDeposits(fEDepEventGAGG, fEDepEventPlastic, fNStepsEvent));
+
+            }
+            else {
+
+                fRunAction->AddMasterShare(eventID, event->GetNumberOfRemainingSubEvents(), fEDepEventGAGG, fEDepEventPlastic, fNStepsEvent, directionBin);
+
+            }
+
+        }
+        else
+#endif
+        {
+
+            fRunAction->AddEDepPlastic(fEDepEventPlastic);
+            fRunAction->AddEDepGAGG(fEDepEventGAGG);
+            fRunAction->AddEventStatistics(eventID, fEDepEventGAGG, fEDepEventPlastic);
+            fRunAction->AddSteps(fNStepsEvent);
+            if (directionBin >= 0) fRunAction->AddDirectional(directionBin, fEDepEventGAGG, fEDepEventPlastic);
+
+        }
+        if (fStepRecorder) fStepRecorder->EndOfEvent();
+
+        if (IsLightEnabled()) {
+
+            fLightModelPlastic->Fold(fEmissionPlastic, fProfile);
+            fRunAction->AddLightPlastic(fLightEventPlastic, fProfile);
+            fLightModelGAGG->Fold(fEmissionGAGG, fProfile);
+            fRunAction->AddLightGAGG(fLightEventGAGG, fProfile);
+
+        }
+
+        if (fEventRecorder && event->GetPrimaryVertex()) {
+
+            EventRecord record;
+            record.energy = event->GetPrimaryVertex()->GetPrimary()->GetKineticEnergy();
+            record.eDepGAGG = fEDepEventGAGG;
+            record.eDepPlastic = fEDepEventPlastic;
+            record.lightGAGG = IsLightEnabled() ? fLightEventGAGG : 0.;
+            record.lightPlastic = IsLightEnabled() ? fLightEventPlastic : 0.;
+            fEventRecorder->Record(record);
+
+        }
+
+        if (fEventTiming) {
+
+            auto eventEnd = std::chrono::steady_clock::now();
+            std::chrono::duration<G4double> eventTime = eventEnd - fEventStart;
+            std::chrono::duration<G4double> endTime = eventEnd.time_since_epoch();
+            fRunAction->AddEventTime(eventTime.count(), endTime.count());
+
+        }
+
+    }
+
+#if G4VERSION_NUMBER >= 1120
+    void EventAction::MergeSubEvent(G4Event* masterEvent, const G4Event* subEvent){
+
+        const auto deposits = static_cast<const SubEventDeposits*>(subEvent->GetUserInformation());
+        if (!deposits) return;
+
+        // The sub-event leaves the remaining ones of its event after this call
+        fRunAction->AddSubEventShare(masterEvent->GetEventID(), masterEvent->GetNumberOfRemainingSubEvents(),
+            deposits->GetEDepGAGG(), deposits->GetEDepPlastic(), deposits->GetNumberOfSteps());
+
+    }
+#endif
+
+    void EventAction::AddLightPlastic(G4double eDep, G4double stepLength, G4double time){
+
+        G4double light = fLightModelPlastic->Light(eDep, stepLength);
+        fLightEventPlastic += light;
+
+        G4int bin = fLightModelPlastic->TimeBin(time);
+        if (bin >= 0) fEmissionPlastic[bin] += light;
+
+    }
+
+    void EventAction::AddLightGAGG(G4double eDep, G4double stepLength, G4double time){
+
+        G4double light = fLightModelGAGG->Light(eDep, stepLength);
+        fLightEventGAGG += light;
+
+        G4int bin = fLightModelGAGG->TimeBin(time);
+        if (bin >= 0) fEmissionGAGG[bin] += light;
 
     }
 
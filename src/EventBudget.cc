@@ -0,0 +1,93 @@
+/// \file B1/src/EventBudget.cc
+/// \brief Implementation of the wall-clock budgeted event allocation
+
+#include "EventBudget.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace B1{
+
+    G4double RelativeVariance(const DoseSums& sums){
+
+        G4double worst = 0.;
+
+        if (sums.eDepGAGG > 0.) {
+
+            G4double relative = sums.RmsEDepGAGG() / sums.eDepGAGG;
+            worst = std::max(worst, relative * relative);
+
+        }
+
+        if (sums.eDepPlastic > 0.) {
+
+            G4double relative = sums.RmsEDepPlastic() / sums.eDepPlastic;
+            worst = std::max(worst, relative * relative);
+
+        }
+
+        return worst * sums.nEvents;
+
+    }
+
+    std::vector<G4long> AllocateEvents(const std::vector<PilotEstimate>& pilots, G4double seconds){
+
+        // Minimax: the relative variance c_i / n_i is equalised to a common
+        // level over the points that receive events, n_i = c_i / level, with
+        // sum_i (n_i - pilot_i) t_i = seconds. Points whose pilot already
+        // beats the level keep their pilot and drop out; repeat until stable.
+        std::vector<G4bool> active(pilots.size());
+        for (size_t i = 0; i < pilots.size(); ++i) {
+
+            active[i] = pilots[i].relativeVariance > 0. && pilots[i].secondsPerEvent > 0.;
+
+        }
+
+        G4double inverseLevel = 0.;
+        G4bool changed = true;
+        while (changed) {
+
+            changed = false;
+
+            G4double spent = seconds;
+            G4double weight = 0.;
+            for (size_t i = 0; i < pilots.size(); ++i) {
+
+                if (!active[i]) continue;
+                spent += pilots[i].nEvents * pilots[i].secondsPerEvent;
+                weight += pilots[i].relativeVariance * pilots[i].secondsPerEvent;
+
+            }
+            if (weight <= 0.) break;
+            inverseLevel = spent / weight;
+
+            for (size_t i = 0; i < pilots.size(); ++i) {
+
+                if (active[i] && pilots[i].relativeVariance * inverseLevel < pilots[i].nEvents) {
+
+                    active[i] = false;
+                    changed = true;
+
+                }
+
+            }
+
+        }
+
+        std::vector<G4long> events(pilots.size());
+        for (size_t i = 0; i < pilots.size(); ++i) {
+
+            events[i] = pilots[i].nEvents;
+            if (active[i]) {
+
+                events[i] = std::max(events[i], static_cast<G4long>(std::floor(pilots[i].relativeVariance * inverseLevel)));
+
+            }
+
+        }
+
+        return events;
+
+    }
+
+}
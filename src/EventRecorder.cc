@@ -0,0 +1,94 @@
+/// \file B1/src/EventRecorder.cc
+/// \brief Implementation of the B1::EventRecorder class
+
+#include "EventRecorder.hh"
+
+#include "G4AutoLock.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <memory>
+
+namespace B1{
+
+    namespace {
+
+        G4Mutex recorderMutex = G4MUTEX_INITIALIZER;
+        std::unique_ptr<std::ofstream> recorderFile;
+        std::map<G4double, G4long> recordedEvents;
+
+    }
+
+    EventRecorder::EventRecorder(const G4String& fileName, G4long maxEvents)
+        : fFileName(fileName), fMaxEvents(maxEvents) {
+
+        fBuffer.reserve(fBufferSize);
+
+    }
+
+    EventRecorder::~EventRecorder(){
+
+        Flush();
+
+    }
+
+    void EventRecorder::Record(const EventRecord& record){
+
+        fBuffer.push_back(record);
+        if (fBuffer.size() >= fBufferSize) Flush();
+
+    }
+
+    void EventRecorder::Flush(){
+
+        if (fBuffer.empty()) return;
+
+        G4AutoLock lock(&recorderMutex);
+
+        // Records of energies that have reached the limit are dropped
+        size_t nEvents = 0;
+        for (const auto& record : fBuffer) {
+
+            G4long& recorded = recordedEvents[record.energy];
+            if (recorded >= fMaxEvents) continue;
+
+            ++recorded;
+            fBuffer[nEvents++] = record;
+
+        }
+
+        if (nEvents > 0) {
+
+            if (!recorderFile) {
+
+                recorderFile = std::make_unique<std::ofstream>(fFileName, std::ios::binary);
+                recorderFile->write(fMagic, sizeof(fMagic));
+
+            }
+
+            recorderFile->write(reinterpret_cast<const char*>(fBuffer.data()), nEvents * sizeof(EventRecord));
+            recorderFile->flush();
+
+        }
+
+        lock.unlock();
+        fBuffer.clear();
+
+    }
+
+    G4bool EventRecorder::Read(const G4String& fileName, std::vector<EventRecord>& records){
+
+        std::ifstream file(fileName, std::ios::binary);
+
+        char magic[sizeof(fMagic)];
+        if (!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), fMagic)) return false;
+
+        EventRecord record;
+        while (file.read(reinterpret_cast<char*>(&record), sizeof(record))) records.push_back(record);
+
+        return true;
+
+    }
+
+}
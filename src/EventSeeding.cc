@@ -0,0 +1,70 @@
+/// \file B1/src/EventSeeding.cc
+/// \brief Implementation of the per-event random stream seeding
+
+#include "EventSeeding.hh"
+
+#include "Randomize.hh"
+
+#include <atomic>
+#include <cstring>
+
+namespace B1{
+
+    namespace {
+
+        std::atomic<G4long> runEventOffset{0};
+
+    }
+
+    std::uint64_t MixSeed(std::uint64_t key){
+
+        // SplitMix64 finaliser
+        key += 0x9e3779b97f4a7c15ULL;
+        key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+        return key ^ (key >> 31);
+
+    }
+
+    void SeedEventEngine(G4long globalSeed, G4double energy, G4long eventID){
+
+        // The energy point is identified by the bits of its value, which keeps
+        // the stream stable for any grid, ordering or sharding of the sweep
+        std::uint64_t energyBits = 0;
+        std::memcpy(&energyBits, &energy, sizeof(energyBits));
+
+        std::uint64_t key = MixSeed(static_cast<std::uint64_t>(globalSeed));
+        key = MixSeed(key ^ energyBits);
+        key = MixSeed(key ^ static_cast<std::uint64_t>(eventID));
+
+        SeedEngine(G4Random::getTheEngine(), key);
+
+    }
+
+    void SeedEngine(CLHEP::HepRandomEngine* engine, std::uint64_t key){
+
+        std::uint64_t key2 = MixSeed(key);
+
+        long seeds[4] = {
+            static_cast<long>(key & 0xffffffffULL),
+            static_cast<long>(key >> 32),
+            static_cast<long>(key2 & 0xffffffffULL),
+            static_cast<long>(key2 >> 32)
+        };
+        engine->setSeeds(seeds, 4);
+
+    }
+
+    void SetRunEventOffset(G4long offset){
+
+        runEventOffset = offset;
+
+    }
+
+    G4long GetRunEventOffset(){
+
+        return runEventOffset;
+
+    }
+
+}
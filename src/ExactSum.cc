@@ -0,0 +1,74 @@
+/// \file B1/src/ExactSum.cc
+/// \brief Implementation of the B1::ExactSum class
+
+#include "ExactSum.hh"
+
+#include <cmath>
+
+namespace B1{
+
+    ExactSum::ExactSum(const G4String& name) : G4VAccumulable(name) {}
+
+    void ExactSum::Add(G4double value){
+
+        __int128 quanta = std::llround(value / fQuantum);
+        ++fN;
+        fSum += quanta;
+        fSum2 += quanta * quanta;
+
+    }
+
+    void ExactSum::Merge(const G4VAccumulable& other){
+
+        const auto& otherSum = static_cast<const ExactSum&>(other);
+        fN += otherSum.fN;
+        fSum += otherSum.fSum;
+        fSum2 += otherSum.fSum2;
+
+    }
+
+    void ExactSum::Reset(){
+
+        fN = 0;
+        fSum = 0;
+        fSum2 = 0;
+
+    }
+
+#if G4VERSION_NUMBER >= 1130
+    void ExactSum::Print(G4PrintOptions) const{
+
+        G4cout << GetName() << ": " << GetSum() << " over " << fN << " events (M2 " << GetM2() << ")" << G4endl;
+
+    }
+#endif
+
+    G4double ExactSum::GetSum() const{
+
+        return static_cast<G4double>(static_cast<long double>(fSum) * fQuantum);
+
+    }
+
+    G4double ExactSum::GetM2() const{
+
+        if (fN == 0) return 0.;
+
+        // With S1 = q N + r and 0 <= r < N, M2 = S2 - S1^2 / N is
+        // (S2 - q S1 - q r) - r^2 / N: the bracket is exact in integers and
+        // the fraction is below N quanta squared
+        __int128 q = fSum / fN;
+        __int128 r = fSum % fN;
+        if (r < 0) {
+
+            r += fN;
+            --q;
+
+        }
+        __int128 exact = fSum2 - q * fSum - q * r;
+        long double m2 = static_cast<long double>(exact) - static_cast<long double>(r) * r / fN;
+
+        return static_cast<G4double>(m2 * fQuantum * fQuantum);
+
+    }
+
+}
@@ -0,0 +1,196 @@
+/// \file B1/src/FieldValidation.cc
+/// \brief Implementation of the validation of the field source against the pencil beam
+
+#include "FieldValidation.hh"
+#include "PhysicsComparison.hh"
+
+#include "G4SystemOfUnits.hh"
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+
+namespace B1{
+
+    namespace {
+
+        // Response per unit fluence in Gy cm2 of both volumes at one energy
+        struct Response{
+
+            G4double nEvents = 0.;
+            G4double gagg = 0.;
+            G4double dGAGG = 0.;
+            G4double plastic = 0.;
+            G4double dPlastic = 0.;
+
+        };
+
+        // Rows of the last direction bin, which ends at cos(theta) = 1
+        std::map<G4double, Response> ReadFieldResponse(const std::filesystem::path& directory){
+
+            std::map<G4double, Response> responses;
+
+            std::ifstream file(directory / "response.txt");
+            std::string line;
+            std::getline(file, line);
+            std::getline(file, line);
+            while (std::getline(file, line)) {
+
+                std::istringstream row(line);
+                G4double energy, cosMin, cosMax;
+                Response response;
+                if (row >> energy >> cosMin >> cosMax >> response.nEvents >> response.gagg >> response.dGAGG >> response.plastic >> response.dPlastic
+                        && cosMax == 1.) {
+
+                    responses[energy] = response;
+
+                }
+
+            }
+
+            return responses;
+
+        }
+
+        // Dose per event of output.txt times the area of the plastic face
+        std::map<G4double, Response> ReadPencilResponse(const std::filesystem::path& directory, G4double plasticRadius){
+
+            std::map<G4double, Response> responses;
+            G4double area = CLHEP::pi * plasticRadius * plasticRadius / cm2;
+
+            std::ifstream file(directory / "output.txt");
+            std::string line;
+            G4bool header = true;
+            while (std::getline(file, line)) {
+
+                if (header) {
+
+                    header = line.rfind("photonEnergy", 0) != 0;
+                    continue;
+
+                }
+
+                std::istringstream row(line);
+                G4double energy, eDepGAGG, dEDepGAGG, eDepPlastic, dEDepPlastic;
+                Response response;
+                if (row >> energy >> response.nEvents >> eDepGAGG >> dEDepGAGG >> eDepPlastic >> dEDepPlastic
+                        >> response.gagg >> response.dGAGG >> response.plastic >> response.dPlastic && response.nEvents > 0.) {
+
+                    G4double scale = area / response.nEvents;
+                    response.gagg *= scale;
+                    response.dGAGG *= scale;
+                    response.plastic *= scale;
+                    response.dPlastic *= scale;
+                    responses[energy] = response;
+
+                }
+
+            }
+
+            return responses;
+
+        }
+
+        G4double Significance(G4double value, G4double dValue, G4double reference, G4double dReference){
+
+            G4double error = std::sqrt(dValue * dValue + dReference * dReference);
+            return error > 0. ? (value - reference) / error : 0.;
+
+        }
+
+    }
+
+    std::vector<FieldDeviation> CompareFieldWithPencil(const std::filesystem::path& fieldDirectory,
+        const std::filesystem::path& pencilDirectory, G4double plasticRadius){
+
+        std::vector<FieldDeviation> deviations;
+
+        auto field = ReadFieldResponse(fieldDirectory);
+        auto pencil = ReadPencilResponse(pencilDirectory, plasticRadius);
+        for (const auto& [energy, response] : field) {
+
+            auto match = pencil.find(energy);
+            if (match == pencil.end()) continue;
+            const Response& reference = match->second;
+
+            FieldDeviation deviation;
+            deviation.energy = energy;
+            deviation.nEventsField = response.nEvents;
+            deviation.nEventsPencil = reference.nEvents;
+            deviation.fieldGAGG = response.gagg;
+            deviation.dFieldGAGG = response.dGAGG;
+            deviation.pencilGAGG = reference.gagg;
+            deviation.dPencilGAGG = reference.dGAGG;
+            deviation.zGAGG = Significance(response.gagg, response.dGAGG, reference.gagg, reference.dGAGG);
+            deviation.fieldPlastic = response.plastic;
+            deviation.dFieldPlastic = response.dPlastic;
+            deviation.pencilPlastic = reference.plastic;
+            deviation.dPencilPlastic = reference.dPlastic;
+            deviation.zPlastic = Significance(response.plastic, response.dPlastic, reference.plastic, reference.dPlastic);
+            deviations.push_back(deviation);
+
+        }
+
+        return deviations;
+
+    }
+
+    int RunFieldValidation(int argc, char** argv, const RunOptions& options){
+
+        const std::filesystem::path fieldDirectory = "validation_field";
+        const std::filesystem::path pencilDirectory = "validation_pencil";
+
+        // The same sweep with and without the source options
+        const std::vector<std::pair<std::filesystem::path, std::vector<std::string>>> sweeps = {
+            {fieldDirectory, {"--validate-field"}},
+            {pencilDirectory, {"--validate-field", "--source", "--source-distance", "--source-angle", "--direction-bins"}}
+        };
+        for (const auto& [directory, skip] : sweeps) {
+
+            std::filesystem::create_directories(directory);
+            std::string command = ChildCommand(argc, argv, directory, skip) + " > run.log 2>&1";
+
+            G4cout << "Running the sweep in " << directory.string() << G4endl;
+            if (std::system(command.c_str()) != 0) {
+
+                G4cerr << "The sweep in " << directory.string() << " failed, see " << (directory / "run.log").string() << G4endl;
+                return 1;
+
+            }
+
+        }
+
+        G4double plasticRadius = 0.5 * std::stod(argv[1]) * cm;
+        auto deviations = CompareFieldWithPencil(fieldDirectory, pencilDirectory, plasticRadius);
+
+        // Oblique directions of the bin deposit differently, so deviations
+        // are only significant for a narrow bin
+        G4double cosMin = 1. - 2. / options.directionBins;
+        std::ofstream report("field_validation.txt");
+        report << "Field bin along +z from cos(theta) = " << cosMin << " (" << std::acos(cosMin) / deg << " deg off the axis) against the pencil beam times the face area" << "\n";
+        report << "photonEnergy / MeV" << "\t" << "nEventsField" << "\t" << "nEventsPencil";
+        for (std::string volume : {"GAGG", "Plastic"}) {
+
+            report << "\t" << "field" << volume << " / (Gy cm2)" << "\t" << "dField" << volume << " / (Gy cm2)"
+                << "\t" << "pencil" << volume << " / (Gy cm2)" << "\t" << "dPencil" << volume << " / (Gy cm2)" << "\t" << "z" << volume;
+
+        }
+        report << "\n";
+
+        for (const auto& deviation : deviations) {
+
+            report << deviation.energy << "\t" << deviation.nEventsField << "\t" << deviation.nEventsPencil
+                << "\t" << deviation.fieldGAGG << "\t" << deviation.dFieldGAGG << "\t" << deviation.pencilGAGG << "\t" << deviation.dPencilGAGG << "\t" << deviation.zGAGG
+                << "\t" << deviation.fieldPlastic << "\t" << deviation.dFieldPlastic << "\t" << deviation.pencilPlastic << "\t" << deviation.dPencilPlastic << "\t" << deviation.zPlastic << "\n";
+
+        }
+
+        G4cout << "Validation written to field_validation.txt" << G4endl;
+        return 0;
+
+    }
+
+}
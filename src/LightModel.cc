@@ -0,0 +1,97 @@
+/// \file B1/src/LightModel.cc
+/// \brief Implementation of the B1::LightModel class
+
+#include "LightModel.hh"
+
+#include <cmath>
+
+namespace B1{
+
+    LightModel::LightModel(const ScintillatorParameters& parameters) : fParameters(parameters), fKernel(fNBins) {
+
+        // Fraction of the light of a deposit that is emitted in each bin
+        // following the bin of the deposit
+        auto emitted = [this](G4double t) {
+
+            G4double fast = 1. - std::exp(-t / fParameters.fastTime);
+            G4double slow = 1. - std::exp(-t / fParameters.slowTime);
+            return fParameters.fastFraction * fast + (1. - fParameters.fastFraction) * slow;
+
+        };
+
+        for (G4int k = 0; k < fNBins; ++k) {
+
+            fKernel[k] = emitted((k + 1) * fBinWidth) - emitted(k * fBinWidth);
+
+        }
+
+    }
+
+    ScintillatorParameters LightModel::GAGG(){
+
+        // GAGG:Ce
+        ScintillatorParameters parameters;
+        parameters.lightYield = 50000. / MeV;
+        parameters.birksConstant = 0.0059 * mm / MeV;
+        parameters.fastTime = 88. * ns;
+        parameters.slowTime = 258. * ns;
+        parameters.fastFraction = 0.91;
+        return parameters;
+
+    }
+
+    ScintillatorParameters LightModel::Plastic(){
+
+        // Polyvinyltoluene based plastic scintillator
+        ScintillatorParameters parameters;
+        parameters.lightYield = 10000. / MeV;
+        parameters.birksConstant = 0.126 * mm / MeV;
+        parameters.fastTime = 2.1 * ns;
+        parameters.slowTime = 2.1 * ns;
+        parameters.fastFraction = 1.;
+        return parameters;
+
+    }
+
+    G4double LightModel::Light(G4double eDep, G4double stepLength) const{
+
+        if (eDep <= 0.) return 0.;
+
+        // Birks' law, steps without length are taken as unquenched
+        G4double quenching = 1.;
+        if (stepLength > 0.) quenching += fParameters.birksConstant * eDep / stepLength;
+
+        return fParameters.lightYield * eDep / quenching;
+
+    }
+
+    G4int LightModel::TimeBin(G4double time) const{
+
+        if (time < 0.) return -1;
+
+        G4double bin = time / fBinWidth;
+        if (bin >= fNBins) return -1;
+
+        return static_cast<G4int>(bin);
+
+    }
+
+    void LightModel::Fold(const std::vector<G4double>& emission, std::vector<G4double>& profile) const{
+
+        profile.assign(fNBins, 0.);
+
+        for (G4int i = 0; i < fNBins; ++i) {
+
+            if (emission[i] == 0.) continue;
+
+            for (G4int k = 0; i + k < fNBins; ++k) {
+
+                profile[i + k] += emission[i] * fKernel[k];
+
+            }
+
+        }
+
+    }
+
+}
@@ -0,0 +1,53 @@
+/// \file B1/src/LightTally.cc
+/// \brief Implementation of the B1::LightTally class
+
+#include "LightTally.hh"
+
+namespace B1{
+
+    LightTally::LightTally(const G4String& name, G4int nBins) : G4VAccumulable(name), fProfile(nBins, 0.) {}
+
+    void LightTally::Add(G4double light, const std::vector<G4double>& profile){
+
+        G4double delta = fN > 0 ? light - fSum / fN : 0.;
+        ++fN;
+        fSum += light;
+        fM2 += delta * (light - fSum / fN);
+        for (size_t i = 0; i < fProfile.size(); ++i) fProfile[i] += profile[i];
+
+    }
+
+    void LightTally::Merge(const G4VAccumulable& other){
+
+        const auto& otherTally = static_cast<const LightTally&>(other);
+        if (fN > 0 && otherTally.fN > 0) {
+
+            G4double delta = otherTally.fSum / otherTally.fN - fSum / fN;
+            fM2 += delta * delta * fN * otherTally.fN / (fN + otherTally.fN);
+
+        }
+        fN += otherTally.fN;
+        fSum += otherTally.fSum;
+        fM2 += otherTally.fM2;
+        for (size_t i = 0; i < fProfile.size(); ++i) fProfile[i] += otherTally.fProfile[i];
+
+    }
+
+    void LightTally::Reset(){
+
+        fN = 0;
+        fSum = 0.;
+        fM2 = 0.;
+        fProfile.assign(fProfile.size(), 0.);
+
+    }
+
+#if G4VERSION_NUMBER >= 1130
+    void LightTally::Print(G4PrintOptions) const{
+
+        G4cout << GetName() << ": " << fSum << " photons over " << fN << " events (M2 " << fM2 << ")" << G4endl;
+
+    }
+#endif
+
+}
@@ -0,0 +1,63 @@
+/// \file B1/src/MemoryUsage.cc
+/// \brief Implementation of the process memory accounting
+
+#include "MemoryUsage.hh"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace B1{
+
+    namespace {
+
+        G4double baselineResident = 0.;
+
+    }
+
+    MemoryUsage CurrentMemoryUsage(){
+
+        MemoryUsage usage;
+
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+
+            std::istringstream fields(line);
+            std::string name;
+            G4double kilobytes = 0.;
+            fields >> name >> kilobytes;
+
+            if (name == "VmRSS:") usage.resident = kilobytes * 1024.;
+            else if (name == "VmHWM:") usage.peak = kilobytes * 1024.;
+
+        }
+
+        return usage;
+
+    }
+
+    void SetMemoryBaseline(){
+
+        baselineResident = CurrentMemoryUsage().resident;
+
+    }
+
+    void PrintMemoryUsage(const G4String& stage, G4int nThreads){
+
+        const G4double megabyte = 1024. * 1024.;
+        MemoryUsage usage = CurrentMemoryUsage();
+
+        G4cout << "Memory " << stage << ": resident " << usage.resident / megabyte << " MB"
+            << ", peak " << usage.peak / megabyte << " MB"
+            << ", threads " << nThreads;
+        if (nThreads > 1 && baselineResident > 0.) {
+
+            G4cout << ", growth per thread since before initialisation " << (usage.resident - baselineResident) / nThreads / megabyte << " MB";
+
+        }
+        G4cout << G4endl;
+
+    }
+
+}
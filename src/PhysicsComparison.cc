@@ -0,0 +1,196 @@
+/// \file B1/src/PhysicsComparison.cc
+/// \brief Implementation of the EM physics speed/accuracy comparison harness
+
+#include "PhysicsComparison.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace B1{
+
+    namespace {
+
+        // Dose per event from output.txt and totals of performance.txt for one
+        // energy
+        struct PointRecord{
+
+            G4double doseGAGG = 0.;
+            G4double dDoseGAGG = 0.;
+            G4double dosePlastic = 0.;
+            G4double dDosePlastic = 0.;
+            G4long nEvents = 0;
+            G4double seconds = 0.;
+            G4long nSteps = 0;
+
+        };
+
+        std::map<G4double, PointRecord> ReadResults(const std::filesystem::path& directory){
+
+            std::map<G4double, PointRecord> records;
+
+            std::ifstream output(directory / "output.txt");
+            std::string line;
+            G4bool header = true;
+            while (std::getline(output, line)) {
+
+                if (header) {
+
+                    header = line.rfind("photonEnergy", 0) != 0;
+                    continue;
+
+                }
+
+                // Rows are totals over their own number of events, which
+                // differs between runs when points come from the cache
+                std::istringstream row(line);
+                G4double energy, nEvents, eDepGAGG, dEDepGAGG, eDepPlastic, dEDepPlastic;
+                PointRecord record;
+                if (row >> energy >> nEvents >> eDepGAGG >> dEDepGAGG >> eDepPlastic >> dEDepPlastic
+                        >> record.doseGAGG >> record.dDoseGAGG >> record.dosePlastic >> record.dDosePlastic && nEvents > 0.) {
+
+                    record.doseGAGG /= nEvents;
+                    record.dDoseGAGG /= nEvents;
+                    record.dosePlastic /= nEvents;
+                    record.dDosePlastic /= nEvents;
+                    records[energy] = record;
+
+                }
+
+            }
+
+            std::ifstream performance(directory / "performance.txt");
+            std::getline(performance, line);
+            while (std::getline(performance, line)) {
+
+                std::istringstream row(line);
+                G4double energy, seconds;
+                G4long nEvents, nSteps;
+                if (row >> energy >> nEvents >> seconds >> nSteps) {
+
+                    auto& record = records[energy];
+                    record.nEvents += nEvents;
+                    record.seconds += seconds;
+                    record.nSteps += nSteps;
+
+                }
+
+            }
+
+            return records;
+
+        }
+
+        // Relative deviation from the reference and its uncertainty
+        void Deviation(G4double value, G4double dValue, G4double reference, G4double dReference, G4double& deviation, G4double& dDeviation){
+
+            deviation = 0.;
+            dDeviation = 0.;
+            if (reference <= 0.) return;
+
+            deviation = value / reference - 1.;
+            dDeviation = std::sqrt(std::pow(dValue / reference, 2) + std::pow(value * dReference / (reference * reference), 2));
+
+        }
+
+    }
+
+    std::string QuoteArgument(const std::string& argument){
+
+        std::string quoted = "'";
+        for (char c : argument) {
+
+            if (c == '\'') quoted += "'\\''";
+            else quoted += c;
+
+        }
+        return quoted + "'";
+
+    }
+
+    std::string ChildCommand(int argc, char** argv, const std::filesystem::path& directory, const std::vector<std::string>& skip){
+
+        std::string executable = argv[0];
+        if (executable.find('/') != std::string::npos) executable = std::filesystem::absolute(executable).string();
+
+        std::string command = "cd " + QuoteArgument(directory.string()) + " && " + QuoteArgument(executable);
+        for (int i = 1; i < 10; ++i) command += " " + QuoteArgument(argv[i]);
+        for (int i = 10; i + 1 < argc; i += 2) {
+
+            std::string name = argv[i];
+            std::string value = argv[i + 1];
+            if (std::find(skip.begin(), skip.end(), name) != skip.end()) continue;
+            if (name == "--cache") value = std::filesystem::absolute(value).string();
+            command += " " + QuoteArgument(name) + " " + QuoteArgument(value);
+
+        }
+        return command;
+
+    }
+
+    int RunPhysicsComparison(int argc, char** argv, const RunOptions& options){
+
+        std::vector<std::map<G4double, PointRecord>> results;
+        for (const auto& choice : options.comparePhysics) {
+
+            std::filesystem::path directory = "physics_" + choice;
+            std::filesystem::create_directories(directory);
+
+            // Same positional arguments and options, minus the harness ones
+            std::string command = ChildCommand(argc, argv, directory, {"--physics", "--performance", "--compare-physics"})
+                + " --physics " + QuoteArgument(choice) + " --performance on > run.log 2>&1";
+
+            G4cout << "Running the sweep with " << choice << " in " << directory.string() << G4endl;
+            if (std::system(command.c_str()) != 0) {
+
+                G4cerr << "The sweep with " << choice << " failed, see " << (directory / "run.log").string() << G4endl;
+                return 1;
+
+            }
+
+            results.push_back(ReadResults(directory));
+
+        }
+
+        // Report against the first constructor of the list
+        std::ofstream report("physics_comparison.txt");
+        report << "reference = " << options.comparePhysics.front() << "\n";
+        report << "physics" << "\t" << "photonEnergy / MeV" << "\t" << "events / s" << "\t" << "steps / event"
+            << "\t" << "devDoseGAGG" << "\t" << "dDevDoseGAGG" << "\t" << "devDosePlastic" << "\t" << "dDevDosePlastic" << "\n";
+
+        const auto& reference = results.front();
+        for (size_t i = 0; i < results.size(); ++i) {
+
+            for (const auto& [energy, record] : results[i]) {
+
+                auto match = reference.find(energy);
+                if (match == reference.end()) continue;
+
+                G4double devGAGG, dDevGAGG, devPlastic, dDevPlastic;
+                Deviation(record.doseGAGG, record.dDoseGAGG, match->second.doseGAGG, match->second.dDoseGAGG, devGAGG, dDevGAGG);
+                Deviation(record.dosePlastic, record.dDosePlastic, match->second.dosePlastic, match->second.dDosePlastic, devPlastic, dDevPlastic);
+
+                // Cache entries from before the cost was recorded have no timing
+                G4double rate = record.seconds > 0. ? record.nEvents / record.seconds : std::numeric_limits<G4double>::quiet_NaN();
+                G4double stepsPerEvent = record.nEvents > 0 ? record.nSteps / (record.nEvents + 0.) : 0.;
+
+                report << options.comparePhysics[i] << "\t" << energy << "\t" << rate << "\t" << stepsPerEvent
+                    << "\t" << devGAGG << "\t" << dDevGAGG << "\t" << devPlastic << "\t" << dDevPlastic << "\n";
+
+            }
+
+        }
+
+        G4cout << "Comparison written to physics_comparison.txt" << G4endl;
+        return 0;
+
+    }
+
+}
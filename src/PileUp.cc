@@ -0,0 +1,216 @@
+/// \file B1/src/PileUp.cc
+/// \brief Implementation of the B1::PileUpSynthesizer class
+
+#include "PileUp.hh"
+
+#include "EventSeeding.hh"
+
+#include "CLHEP/Random/MixMaxRng.h"
+#include "G4Exception.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <set>
+#include <sstream>
+
+namespace B1{
+
+    PileUpSynthesizer::PileUpSynthesizer(const std::vector<EventRecord>& library, G4double energy, const PileUpSettings& settings)
+        : fSettings(settings) {
+
+        // Recorded energies carry the precision of the /gun/energy command,
+        // so the library point is the nearest recorded energy
+        std::set<G4double> energies;
+        for (const auto& record : library) energies.insert(record.energy);
+
+        G4double recordedEnergy = -1.;
+        for (G4double e : energies) {
+
+            if (recordedEnergy < 0. || std::abs(e - energy) < std::abs(recordedEnergy - energy)) recordedEnergy = e;
+
+        }
+
+        if (recordedEnergy < 0. || std::abs(recordedEnergy - energy) > 1e-3 * energy) {
+
+            std::ostringstream message;
+            message << "No recorded events at " << energy / MeV << " MeV; recorded energies (MeV):";
+            for (G4double e : energies) message << " " << e / MeV;
+            G4Exception("PileUpSynthesizer::PileUpSynthesizer", "B1PileUp001", FatalException, message.str().c_str());
+            return;
+
+        }
+
+        G4double maxEDep = 0.;
+        G4double maxLight = 0.;
+        for (const auto& record : library) {
+
+            if (record.energy != recordedEnergy) continue;
+
+            ++fNEvents;
+            if (record.eDepGAGG + record.eDepPlastic <= 0.) continue;
+
+            // Both scintillators are read by the photodetector of the phoswich
+            G4double light = record.lightGAGG + record.lightPlastic;
+            fEDepGAGG.push_back(record.eDepGAGG);
+            fEDepPlastic.push_back(record.eDepPlastic);
+            fLight.push_back(light);
+
+            if (record.eDepGAGG + record.eDepPlastic >= fSettings.threshold) ++fNAboveThreshold;
+            maxEDep = std::max({maxEDep, record.eDepGAGG, record.eDepPlastic});
+            maxLight = std::max(maxLight, light);
+
+        }
+
+        if (fSettings.maxEnergy <= 0.) fSettings.maxEnergy = (maxEDep > 0.) ? 2. * maxEDep : energy;
+        if (fSettings.maxLight <= 0.) fSettings.maxLight = 2. * maxLight;
+
+    }
+
+    PileUpSpectrum PileUpSynthesizer::Synthesize(G4double rate) const{
+
+        PileUpSpectrum spectrum;
+        spectrum.rate = rate;
+        spectrum.eDepGAGG.assign(fSettings.nBins, 0.);
+        spectrum.eDepPlastic.assign(fSettings.nBins, 0.);
+        if (fSettings.maxLight > 0.) spectrum.light.assign(fSettings.nBins, 0.);
+
+        G4long nDepositing = fEDepGAGG.size();
+        if (nDepositing == 0 || rate <= 0.) return spectrum;
+
+        // No pulse would ever open, and the requested pulses never come
+        if (fNAboveThreshold == 0) {
+
+            G4Exception("PileUpSynthesizer::Synthesize", "B1PileUp005", JustWarning,
+                "No recorded event deposits the threshold, the spectrum stays empty");
+            return spectrum;
+
+        }
+
+        // Events without deposit leave no trace, so only the depositing
+        // events are drawn, at the thinned rate
+        G4double depositingRate = rate * nDepositing / fNEvents;
+
+        std::uint64_t rateBits;
+        std::memcpy(&rateBits, &rate, sizeof(rateBits));
+        CLHEP::MixMaxRng engine;
+        SeedEngine(&engine, MixSeed(MixSeed(static_cast<std::uint64_t>(fSettings.seed)) ^ rateBits));
+
+        G4double energyWidth = fSettings.maxEnergy / fSettings.nBins;
+        G4double lightWidth = fSettings.maxLight / fSettings.nBins;
+        auto fill = [this](std::vector<G4double>& histogram, G4double value, G4double width) {
+
+            if (histogram.empty()) return;
+            G4double bin = value / width;
+            if (bin < fSettings.nBins) histogram[static_cast<size_t>(bin)] += 1.;
+
+        };
+
+        // Pulse being shaped, and the end of the dead time
+        G4bool open = false;
+        G4double pulseEnd = 0.;
+        G4double deadEnd = -std::numeric_limits<G4double>::infinity();
+        G4double pulseGAGG = 0.;
+        G4double pulsePlastic = 0.;
+        G4double pulseLight = 0.;
+        G4int pulseEvents = 0;
+
+        auto closePulse = [&]() {
+
+            if (pulseGAGG > 0.) fill(spectrum.eDepGAGG, pulseGAGG, energyWidth);
+            if (pulsePlastic > 0.) fill(spectrum.eDepPlastic, pulsePlastic, energyWidth);
+            if (pulseLight > 0.) fill(spectrum.light, pulseLight, lightWidth);
+
+            ++spectrum.nPulses;
+            if (pulseEvents > 1) ++spectrum.nPiledUp;
+            open = false;
+
+        };
+
+        // Arrivals are drawn in blocks: the gaps and the event choices of a
+        // block are independent loops over plain arrays, only the pulse
+        // processing is sequential
+        constexpr size_t blockSize = 4096;
+        std::vector<G4double> uniforms(2 * blockSize);
+        std::vector<G4double> gaps(blockSize);
+        std::vector<G4long> picks(blockSize);
+
+        G4double time = 0.;
+        while (spectrum.nPulses < fSettings.nPulses) {
+
+            engine.flatArray(static_cast<G4int>(uniforms.size()), uniforms.data());
+            for (size_t i = 0; i < blockSize; ++i) gaps[i] = -std::log(uniforms[i]) / depositingRate;
+            for (size_t i = 0; i < blockSize; ++i) {
+
+                picks[i] = std::min(static_cast<G4long>(uniforms[blockSize + i] * nDepositing), nDepositing - 1);
+
+            }
+
+            for (size_t i = 0; i < blockSize && spectrum.nPulses < fSettings.nPulses; ++i) {
+
+                time += gaps[i];
+                G4long k = picks[i];
+
+                if (open && time < pulseEnd) {
+
+                    pulseGAGG += fEDepGAGG[k];
+                    pulsePlastic += fEDepPlastic[k];
+                    pulseLight += fLight[k];
+                    ++pulseEvents;
+                    if (fSettings.paralyzable) deadEnd = std::max(deadEnd, time + fSettings.deadTime);
+                    continue;
+
+                }
+
+                if (open) {
+
+                    closePulse();
+                    if (spectrum.nPulses >= fSettings.nPulses) break;
+
+                }
+
+                if (time < deadEnd) {
+
+                    ++spectrum.nLost;
+                    if (fSettings.paralyzable) deadEnd = time + fSettings.deadTime;
+                    continue;
+
+                }
+
+                if (fEDepGAGG[k] + fEDepPlastic[k] < fSettings.threshold) {
+
+                    ++spectrum.nBelowThreshold;
+                    continue;
+
+                }
+
+                open = true;
+                pulseEnd = time + fSettings.shapingTime;
+                deadEnd = time + std::max(fSettings.shapingTime, fSettings.deadTime);
+                pulseGAGG = fEDepGAGG[k];
+                pulsePlastic = fEDepPlastic[k];
+                pulseLight = fLight[k];
+                pulseEvents = 1;
+
+            }
+
+        }
+
+        // Counts per second of real time
+        spectrum.realTime = time;
+        if (time > 0.) {
+
+            for (auto* histogram : {&spectrum.eDepGAGG, &spectrum.eDepPlastic, &spectrum.light}) {
+
+                for (auto& counts : *histogram) counts /= time / second;
+
+            }
+
+        }
+
+        return spectrum;
+
+    }
+
+}
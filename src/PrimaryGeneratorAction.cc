@@ -2,7 +2,11 @@
 /// \brief Implementation of the B1::PrimaryGeneratorAction class
 
 #include "PrimaryGeneratorAction.hh"
+#include "DetectorConstruction.hh"
+#include "EventSeeding.hh"
 
+#include "G4Box.hh"
+#include "G4Event.hh"
 #include "G4Tubs.hh"
 #include "G4LogicalVolume.hh"
 #include "G4LogicalVolumeStore.hh"
@@ -12,8 +16,14 @@
 #include "Randomize.hh"
 
 namespace B1{
+
+	namespace {
+
+		std::vector<G4double> fieldEnergies;
+
+	}
 	
-	PrimaryGeneratorAction::PrimaryGeneratorAction(){
+	PrimaryGeneratorAction::PrimaryGeneratorAction(const RunOptions& options) : fOptions(options) {
 
 		G4int nParticle = 1;
 		fParticleGun = new G4ParticleGun(nParticle);
@@ -36,13 +46,35 @@ namespace B1{
 
 	void PrimaryGeneratorAction::GeneratePrimaries(G4Event* event){
 
+		// Energy of the event in a field run of several energies, whose
+		// events are numbered per energy as in a run of that energy alone
+		G4long eventNumber = event->GetEventID();
+		if (fOptions.sourceMode == SourceMode::Field && !fieldEnergies.empty()) {
+
+			fParticleGun->SetParticleEnergy(fieldEnergies[FieldEnergyIndex(event->GetEventID())]);
+			eventNumber /= static_cast<G4long>(fieldEnergies.size());
+
+		}
+
+		// Reseed before any random number of the event is drawn
+		if (fOptions.deterministicSeeding) {
+
+			SeedEventEngine(fOptions.globalSeed, fParticleGun->GetParticleEnergy(), fOptions.eventOffset + GetRunEventOffset() + eventNumber);
+
+		}
+
 		G4double plasticRadius = 0;
 		G4double plasticSizeZ = 0;
 
-		if (!fPlasticSolid) {
+		// Looked up again when the geometry was rebuilt
+		G4int geometryVersion = DetectorConstruction::GetGeometryVersion();
+		if (!fPlasticSolid || geometryVersion != fGeometryVersion) {
 
 			G4LogicalVolume* plasticLV = G4LogicalVolumeStore::GetInstance()->GetVolume("Plastic");
-			if (plasticLV) fPlasticSolid = dynamic_cast<G4Tubs*>(plasticLV->GetSolid());
+			fPlasticSolid = plasticLV ? dynamic_cast<G4Tubs*>(plasticLV->GetSolid()) : nullptr;
+			G4LogicalVolume* worldLV = G4LogicalVolumeStore::GetInstance()->GetVolume("World");
+			fWorldSolid = worldLV ? dynamic_cast<G4Box*>(worldLV->GetSolid()) : nullptr;
+			fGeometryVersion = geometryVersion;
 
 		}
 
@@ -54,15 +86,175 @@ namespace B1{
 
 		}
 
-		G4double randomAngle = 2 * CLHEP::pi * G4UniformRand();
-		G4double randomRadius = plasticRadius * pow(G4UniformRand(), 0.5);
-		G4double x0 = randomRadius * std::cos(randomAngle);
-		G4double y0 = randomRadius * std::sin(randomAngle);
-		G4double z0 = -0.5 * plasticSizeZ;
+		G4double boundingRadius = BoundingRadius(plasticRadius, 0.5 * plasticSizeZ);
+		G4ThreeVector axis(std::sin(fOptions.sourceAngle), 0., std::cos(fOptions.sourceAngle));
+
+		switch (fOptions.sourceMode) {
+
+			case SourceMode::Point: {
+
+				// Isotropic emission restricted to the cone subtending the
+				// bounding sphere, aimed at the detector centre
+				G4double cosAlpha = std::sqrt(1. - std::pow(boundingRadius / fOptions.sourceDistance, 2));
+				G4double cosTheta = 1. - G4UniformRand() * (1. - cosAlpha);
+				G4double sinTheta = std::sqrt(1. - cosTheta * cosTheta);
+				G4double phi = 2 * CLHEP::pi * G4UniformRand();
+
+				G4ThreeVector direction(sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta);
+				direction.rotateUz(axis);
+
+				fParticleGun->SetParticlePosition(-fOptions.sourceDistance * axis);
+				fParticleGun->SetParticleMomentumDirection(direction);
+				break;
+
+			}
+
+			case SourceMode::Field: {
+
+				G4double u1 = G4UniformRand();
+				G4double u2 = G4UniformRand();
+				axis = FieldDirection(u1, u2);
+				[[fallthrough]];
+
+			}
+
+			case SourceMode::Beam: {
+
+				G4double u1 = G4UniformRand();
+				G4double u2 = G4UniformRand();
+				fParticleGun->SetParticlePosition(BeamStart(axis, boundingRadius, u1, u2));
+				fParticleGun->SetParticleMomentumDirection(axis);
+				break;
+
+			}
+
+			default: {
+
+				G4double randomAngle = 2 * CLHEP::pi * G4UniformRand();
+				G4double randomRadius = plasticRadius * pow(G4UniformRand(), 0.5);
+				G4double x0 = randomRadius * std::cos(randomAngle);
+				G4double y0 = randomRadius * std::sin(randomAngle);
+				G4double z0 = -0.5 * plasticSizeZ;
+
+				fParticleGun->SetParticlePosition(G4ThreeVector(x0, y0, z0));
+				break;
+
+			}
+
+		}
+
+		// A primary starting outside the world would be dropped by Geant4 but
+		// still counted in the normalisation
+		G4ThreeVector position = fParticleGun->GetParticlePosition();
+		if (fWorldSolid && (std::abs(position.x()) > fWorldSolid->GetXHalfLength() || std::abs(position.y()) > fWorldSolid->GetYHalfLength() || std::abs(position.z()) > fWorldSolid->GetZHalfLength())) {
+
+			G4Exception("B1::PrimaryGeneratorAction::GeneratePrimaries", "B1Source002", FatalException,
+				"The primary starts outside the world, which must contain the sphere of SourceExtent()");
+
+		}
 
-		fParticleGun->SetParticlePosition(G4ThreeVector(x0, y0, z0));
 		fParticleGun->GeneratePrimaryVertex(event);
 
 	}
 
-}
\ No newline at end of file
+	G4double PrimaryGeneratorAction::BoundingRadius(G4double plasticRadius, G4double plasticHalfZ){
+
+		return std::sqrt(plasticRadius * plasticRadius + plasticHalfZ * plasticHalfZ);
+
+	}
+
+	G4ThreeVector PrimaryGeneratorAction::FieldDirection(G4double u1, G4double u2){
+
+		// Direction of a broad beam drawn uniformly over the sphere
+		G4double cosTheta = 2. * u1 - 1.;
+		G4double sinTheta = std::sqrt(1. - cosTheta * cosTheta);
+		G4double phi = 2 * CLHEP::pi * u2;
+		return G4ThreeVector(sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta);
+
+	}
+
+	G4ThreeVector PrimaryGeneratorAction::BeamStart(const G4ThreeVector& axis, G4double boundingRadius, G4double u1, G4double u2){
+
+		// Parallel rays through the disk that covers the projection of the
+		// bounding sphere, starting on its tangent plane
+		G4double randomAngle = 2 * CLHEP::pi * u1;
+		G4double randomRadius = boundingRadius * std::sqrt(u2);
+		G4ThreeVector offset(randomRadius * std::cos(randomAngle), randomRadius * std::sin(randomAngle), 0.);
+		offset.rotateUz(axis);
+
+		return -boundingRadius * axis + offset;
+
+	}
+
+	G4double PrimaryGeneratorAction::SourceExtent(const RunOptions& options, G4double plasticRadius, G4double plasticHalfZ){
+
+		G4double boundingRadius = BoundingRadius(plasticRadius, plasticHalfZ);
+
+		switch (options.sourceMode) {
+
+			case SourceMode::Point:
+				return options.sourceDistance;
+
+			// The launch disk of radius R is centred at distance R from the
+			// detector centre, its rim lies at sqrt(2) R
+			case SourceMode::Beam:
+			case SourceMode::Field:
+				return std::sqrt(2.) * boundingRadius;
+
+			default:
+				return 0.;
+
+		}
+
+	}
+
+	G4double PrimaryGeneratorAction::GeometricWeight(const RunOptions& options, G4double plasticRadius, G4double plasticHalfZ){
+
+		G4double boundingRadius = BoundingRadius(plasticRadius, plasticHalfZ);
+
+		switch (options.sourceMode) {
+
+			case SourceMode::Point: {
+
+				if (options.sourceDistance <= boundingRadius) {
+
+					G4Exception("B1::PrimaryGeneratorAction::GeometricWeight", "B1Source001", FatalException,
+						"The point source must lie outside the sphere bounding the plastic");
+
+				}
+
+				G4double cosAlpha = std::sqrt(1. - std::pow(boundingRadius / options.sourceDistance, 2));
+				return 0.5 * (1. - cosAlpha);
+
+			}
+
+			case SourceMode::Beam:
+			case SourceMode::Field:
+				return CLHEP::pi * boundingRadius * boundingRadius / cm2;
+
+			default:
+				return 1.;
+
+		}
+
+	}
+
+	void PrimaryGeneratorAction::SetFieldEnergies(const std::vector<G4double>& energies){
+
+		fieldEnergies = energies;
+
+	}
+
+	const std::vector<G4double>& PrimaryGeneratorAction::GetFieldEnergies(){
+
+		return fieldEnergies;
+
+	}
+
+	G4int PrimaryGeneratorAction::FieldEnergyIndex(G4int eventID){
+
+		return fieldEnergies.empty() ? 0 : eventID % static_cast<G4int>(fieldEnergies.size());
+
+	}
+
+}
@@ -0,0 +1,180 @@
+/// \file B1/src/ResultCache.cc
+/// \brief Implementation of the B1::ResultCache class
+
+#include "ResultCache.hh"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace B1{
+
+    ResultCache::ResultCache(const G4String& directory, const G4String& configuration)
+        : fDirectory(directory), fConfiguration(configuration) {
+
+        std::filesystem::create_directories(std::string(fDirectory));
+
+    }
+
+    G4bool ResultCache::Lookup(G4double energy, DoseSums& sums) const{
+
+        std::string key = EntryKey(energy);
+        std::ifstream file(EntryPath(key));
+        if (!file) return false;
+
+        std::string storedKey;
+        std::getline(file, storedKey);
+        if (storedKey != key) return false;
+
+        DoseSums stored;
+        file >> stored.nEvents
+             >> stored.eDepGAGG >> stored.eDepM2GAGG
+             >> stored.eDepPlastic >> stored.eDepM2Plastic;
+        if (!file) return false;
+
+        // Optional blocks: light sums and profiles, per-direction sums,
+        // streaming moments of both volumes, batch sums and the run cost
+        std::string block;
+        size_t size = 0;
+        while (file >> block >> size) {
+
+            if (block == "light") {
+
+                file >> stored.lightGAGG >> stored.lightM2GAGG
+                     >> stored.lightPlastic >> stored.lightM2Plastic;
+                stored.profileGAGG.resize(size);
+                stored.profilePlastic.resize(size);
+                for (auto& value : stored.profileGAGG) file >> value;
+                for (auto& value : stored.profilePlastic) file >> value;
+
+            }
+            else if (block == "directional") {
+
+                stored.directional.resize(size);
+                for (auto& value : stored.directional) file >> value;
+
+            }
+            else if (block == "stats") {
+
+                if (size != 2) return false;
+                for (StreamingStats* stats : {&stored.statsGAGG, &stored.statsPlastic}) {
+
+                    file >> stats->n >> stats->mean >> stats->m2 >> stats->m3 >> stats->m4;
+
+                }
+
+            }
+            else if (block == "batches") {
+
+                stored.batches.resize(size);
+                for (auto& value : stored.batches) file >> value;
+
+            }
+            else if (block == "cost") {
+
+                if (size != 2) return false;
+                file >> stored.seconds >> stored.nSteps;
+
+            }
+            else {
+
+                return false;
+
+            }
+
+            if (!file) return false;
+
+        }
+
+        sums = stored;
+        return true;
+
+    }
+
+    void ResultCache::Store(G4double energy, const DoseSums& sums) const{
+
+        std::string key = EntryKey(energy);
+        std::string path = EntryPath(key);
+
+        // Write aside and rename, so concurrent jobs never read half an entry
+        std::string tmpPath = path + ".tmp";
+        {
+            std::ofstream file(tmpPath);
+            file << key << "\n" << std::setprecision(17)
+                 << sums.nEvents << "\n"
+                 << sums.eDepGAGG << " " << sums.eDepM2GAGG << "\n"
+                 << sums.eDepPlastic << " " << sums.eDepM2Plastic << "\n";
+
+            if (sums.HasLight()) {
+
+                file << "light " << sums.profileGAGG.size() << "\n"
+                     << sums.lightGAGG << " " << sums.lightM2GAGG << " "
+                     << sums.lightPlastic << " " << sums.lightM2Plastic << "\n";
+                for (auto value : sums.profileGAGG) file << value << " ";
+                file << "\n";
+                for (auto value : sums.profilePlastic) file << value << " ";
+                file << "\n";
+
+            }
+
+            if (sums.HasDirectional()) {
+
+                file << "directional " << sums.directional.size() << "\n";
+                for (auto value : sums.directional) file << value << " ";
+                file << "\n";
+
+            }
+
+            if (sums.HasStatistics()) {
+
+                file << "stats 2\n";
+                for (const StreamingStats* stats : {&sums.statsGAGG, &sums.statsPlastic}) {
+
+                    file << stats->n << " " << stats->mean << " " << stats->m2 << " " << stats->m3 << " " << stats->m4 << "\n";
+
+                }
+
+            }
+
+            if (!sums.batches.empty()) {
+
+                file << "batches " << sums.batches.size() << "\n";
+                for (auto value : sums.batches) file << value << " ";
+                file << "\n";
+
+            }
+
+            file << "cost 2\n" << sums.seconds << " " << sums.nSteps << "\n";
+        }
+        std::filesystem::rename(tmpPath, path);
+
+    }
+
+    std::string ResultCache::EntryKey(G4double energy) const{
+
+        std::ostringstream key;
+        key << "format=" << fFormat << ";" << fConfiguration << ";energy=" << std::hexfloat << energy;
+        return key.str();
+
+    }
+
+    std::string ResultCache::EntryPath(const std::string& key) const{
+
+        // FNV-1a
+        std::uint64_t hash = 0xcbf29ce484222325ULL;
+        for (unsigned char c : key) {
+
+            hash ^= c;
+            hash *= 0x100000001b3ULL;
+
+        }
+
+        std::ostringstream name;
+        name << std::hex << std::setw(16) << std::setfill('0') << hash << ".txt";
+        return (std::filesystem::path(std::string(fDirectory)) / name.str()).string();
+
+    }
+
+}
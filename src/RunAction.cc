@@ -3,9 +3,11 @@
 
 #include "RunAction.hh"
 #include "DetectorConstruction.hh"
+#include "MemoryUsage.hh"
 #include "PrimaryGeneratorAction.hh"
 
 #include "G4AccumulableManager.hh"
+#include "G4Exception.hh"
 #include "G4LogicalVolume.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4ParticleGun.hh"
@@ -14,11 +16,12 @@
 #include "G4SystemOfUnits.hh"
 #include "G4UnitsTable.hh"
 
-#include <filesystem>
+#include <algorithm>
+#include <sstream>
 
 namespace B1{
 
-    RunAction::RunAction(){
+    RunAction::RunAction(const RunOptions& options) : fStatistics("Statistics", options.nBatches), fVerbose(options.verbose) {
 
         // Add new units for dose
         const G4double milligray = 1.e-3 * gray;
@@ -33,14 +36,30 @@ namespace B1{
 
         // Register accumulable to the accumulable manager
         G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
-        accumulableManager->Register(fEDepGAGG);
-        accumulableManager->Register(fEDep2GAGG);
-        accumulableManager->Register(fEDepPlastic);
-        accumulableManager->Register(fEDep2Plastic);
+        accumulableManager->Register(&fEDepGAGG);
+        accumulableManager->Register(&fEDepPlastic);
+        accumulableManager->Register(&fStatistics);
+        accumulableManager->Register(fNSteps);
+        accumulableManager->Register(fBusyTime);
+        accumulableManager->Register(fFirstIdleTime);
+        if (options.lightModel) {
+
+            fLightGAGG = std::make_unique<LightTally>("LightGAGG", LightModel::fNBins);
+            fLightPlastic = std::make_unique<LightTally>("LightPlastic", LightModel::fNBins);
+            accumulableManager->Register(fLightGAGG.get());
+            accumulableManager->Register(fLightPlastic.get());
+
+        }
+        if (options.sourceMode == SourceMode::Field) {
+
+            fDirectional = std::make_unique<DirectionalTally>("Directional", options.directionBins);
+            accumulableManager->Register(fDirectional.get());
+
+        }
 
     }
 
-    void RunAction::BeginOfRunAction(const G4Run*){
+    void RunAction::BeginOfRunAction(const G4Run* run){
 
         // Inform the runManager to save random number seed
         G4RunManager::GetRunManager()->SetRandomNumberStore(false);
@@ -48,6 +67,10 @@ namespace B1{
         // Reset accumulables to their initial values
         G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
         accumulableManager->Reset();
+        if (fDirectional) fDirectional->SetNumberOfEnergies(static_cast<G4int>(PrimaryGeneratorAction::GetFieldEnergies().size()));
+        fStatistics.SetRunLength(run->GetNumberOfEventToBeProcessed());
+        fLastEventEnd = 0.;
+        fDoseSums = DoseSums();
 
     }
 
@@ -56,29 +79,43 @@ namespace B1{
         G4int nofEvents = run->GetNumberOfEvent();
         if (nofEvents == 0) return;
 
+        // Events still waiting for sub-events, and the end of the last event
+        // of this thread
+        ScoreEventShares();
+        if (fLastEventEnd > 0. && fLastEventEnd < fFirstIdleTime.GetValue()) fFirstIdleTime = fLastEventEnd;
+
         // Merge accumulables
         G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
         accumulableManager->Merge();
 
         if (IsMaster()) {
 
+            // Keep the raw sums of the run for the caller
+            fDoseSums.nEvents = nofEvents;
+            fDoseSums.eDepGAGG = fEDepGAGG.GetSum();
+            fDoseSums.eDepM2GAGG = fEDepGAGG.GetM2();
+            fDoseSums.eDepPlastic = fEDepPlastic.GetSum();
+            fDoseSums.eDepM2Plastic = fEDepPlastic.GetM2();
+            if (fLightGAGG) {
+
+                fDoseSums.lightGAGG = fLightGAGG->GetSum();
+                fDoseSums.lightM2GAGG = fLightGAGG->GetM2();
+                fDoseSums.lightPlastic = fLightPlastic->GetSum();
+                fDoseSums.lightM2Plastic = fLightPlastic->GetM2();
+                fDoseSums.profileGAGG = fLightGAGG->GetProfile();
+                fDoseSums.profilePlastic = fLightPlastic->GetProfile();
+
+            }
+            if (fDirectional) fDoseSums.directional = fDirectional->GetValues();
+            fDoseSums.statsGAGG = fStatistics.GetGAGG();
+            fDoseSums.statsPlastic = fStatistics.GetPlastic();
+            fDoseSums.batches = fStatistics.GetBatches();
+
             // Compute total energy deposit in a run and its variance
-            G4double eDepGAGG = fEDepGAGG.GetValue();
-            G4double eDep2GAGG = fEDep2GAGG.GetValue();
-            G4double eDepPlastic = fEDepPlastic.GetValue();
-            G4double eDep2Plastic = fEDep2Plastic.GetValue();
-
-            G4double rmsEDepPlastic = eDep2Plastic - eDepPlastic * eDepPlastic / (nofEvents + 0.);
-            if (rmsEDepPlastic > 0.)
-                rmsEDepPlastic = std::sqrt(rmsEDepPlastic);
-            else
-                rmsEDepPlastic = 0.;
-
-            G4double rmsEDepGAGG = eDep2GAGG - eDepGAGG * eDepGAGG / (nofEvents + 0.);
-            if (rmsEDepGAGG > 0.)
-                rmsEDepGAGG = std::sqrt(rmsEDepGAGG);
-            else
-                rmsEDepGAGG = 0.;
+            G4double eDepGAGG = fDoseSums.eDepGAGG;
+            G4double rmsEDepGAGG = fDoseSums.RmsEDepGAGG();
+            G4double eDepPlastic = fDoseSums.eDepPlastic;
+            G4double rmsEDepPlastic = fDoseSums.RmsEDepPlastic();
 
             // Compute dose and its variance
             const auto detConstruction = static_cast<const DetectorConstruction*>(
@@ -94,16 +131,6 @@ namespace B1{
             G4double dosePlastic = eDepPlastic / massPlastic;
             G4double rmsDosePlastic = rmsEDepPlastic / massPlastic;
 
-            // Write output file
-            std::string filename = "output.txt";
-            if (std::filesystem::exists(filename)) {
-
-                std::ofstream file;
-                file.open(filename, std::ios::app);
-                file << eDepGAGG / GeV << "\t" << rmsEDepGAGG / GeV << "\t" << eDepPlastic / GeV << "\t" << rmsEDepPlastic / GeV << "\t" << doseGAGG / gray << "\t" << rmsDoseGAGG / gray << "\t" << dosePlastic / gray << "\t" << rmsDosePlastic / gray << "\n";
-                file.close();
-            }
-
             // Print
             G4cout
             << "Deposited energy in GAGG: "
@@ -119,24 +146,100 @@ namespace B1{
             << G4BestUnit(dosePlastic, "Dose") << " rms = " << G4BestUnit(rmsDosePlastic, "Dose")
             << G4endl
             << "------------------------------------------------------------"
-            << G4endl
             << G4endl;
 
+            if (fVerbose > 0) {
+
+                PrintMemoryUsage("at end of run " + std::to_string(run->GetRunID()), G4RunManager::GetRunManager()->GetNumberOfThreads());
+                G4cout << G4endl;
+
+            }
+
         }
 
     }
 
+    void RunAction::AddMasterShare(G4int eventID, G4int remainingSubEvents, G4double eDepGAGG, G4double eDepPlastic, G4long nSteps, G4int directionBin){
+
+        // Sub-events are merged from the worker threads while the master
+        // tracks the next events
+        G4AutoLock lock(&fEventSharesMutex);
+        auto share = fEventShares.try_emplace(eventID).first;
+        share->second.eDepGAGG += eDepGAGG;
+        share->second.eDepPlastic += eDepPlastic;
+        share->second.nSteps += nSteps;
+        share->second.directionBin = directionBin;
+        share->second.masterDone = true;
+
+        if (remainingSubEvents == 0) ScoreEventShare(share);
+
+    }
+
+    void RunAction::AddSubEventShare(G4int eventID, G4int remainingSubEvents, G4double eDepGAGG, G4double eDepPlastic, G4long nSteps){
+
+        G4AutoLock lock(&fEventSharesMutex);
+        auto share = fEventShares.try_emplace(eventID).first;
+        share->second.eDepGAGG += eDepGAGG;
+        share->second.eDepPlastic += eDepPlastic;
+        share->second.nSteps += nSteps;
+
+        if (share->second.masterDone && remainingSubEvents <= 1) ScoreEventShare(share);
+
+    }
+
+    void RunAction::ScoreEventShare(std::map<G4int, EventShare>::iterator share){
+
+        const auto& [eventID, event] = *share;
+        AddEDepGAGG(event.eDepGAGG);
+        AddEDepPlastic(event.eDepPlastic);
+        AddEventStatistics(eventID, event.eDepGAGG, event.eDepPlastic);
+        AddSteps(event.nSteps);
+        if (fDirectional && event.directionBin >= 0) AddDirectional(event.directionBin, event.eDepGAGG, event.eDepPlastic);
+        fEventShares.erase(share);
+
+    }
+
+    void RunAction::ScoreEventShares(){
+
+        // Events are scored as they complete, so anything left over at the end
+        // of the run is an event with missing parts: either the master share
+        // or some of the sub-events never arrived. They are scored with what
+        // arrived, which biases the totals, and reported.
+        G4AutoLock lock(&fEventSharesMutex);
+        if (fEventShares.empty()) return;
+
+        G4int nWithoutMaster = 0;
+        for (const auto& share : fEventShares) {
+
+            if (!share.second.masterDone) ++nWithoutMaster;
+
+        }
+
+        std::ostringstream message;
+        message << fEventShares.size() << " events of the run were incomplete at its end and are scored with partial deposits: "
+        << fEventShares.size() - nWithoutMaster << " missing sub-events, " << nWithoutMaster << " missing the master share";
+        G4Exception("B1::RunAction::ScoreEventShares", "B1Run001", JustWarning, message.str().c_str());
+
+        while (!fEventShares.empty()) ScoreEventShare(fEventShares.begin());
+
+    }
+
+    void RunAction::AddEventTime(G4double seconds, G4double endTime){
+
+        fBusyTime += seconds;
+        fLastEventEnd = endTime;
+
+    }
+
     void RunAction::AddEDepGAGG(G4double eDep){
 
-        fEDepGAGG += eDep;
-        fEDep2GAGG += eDep * eDep;
+        fEDepGAGG.Add(eDep);
 
     }
 
     void RunAction::AddEDepPlastic(G4double eDep){
 
-        fEDepPlastic += eDep;
-        fEDep2Plastic += eDep * eDep;
+        fEDepPlastic.Add(eDep);
 
     }
 
@@ -0,0 +1,266 @@
+/// \file B1/src/RunOptions.cc
+/// \brief Implementation of the B1::RunOptions parsing
+
+#include "RunOptions.hh"
+
+#include "G4Exception.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Version.hh"
+
+#include <sstream>
+#include <string>
+
+namespace B1{
+
+    G4bool ParseSwitch(const std::string& name, const std::string& value){
+
+        if (value != "on" && value != "off") {
+
+            G4Exception("B1::ParseSwitch", "B1Options006", FatalException,
+                ("Invalid value " + value + " for option " + name + ", expected on or off").c_str());
+
+        }
+        return value == "on";
+
+    }
+
+    RunOptions ParseRunOptions(int argc, char** argv, int first){
+
+        RunOptions options;
+
+        for (int i = first; i < argc; ++i) {
+
+            std::string name = argv[i];
+            if (i + 1 >= argc) {
+
+                G4Exception("B1::ParseRunOptions", "B1Options001", FatalException,
+                    ("Missing value for option " + name).c_str());
+
+            }
+            std::string value = argv[++i];
+
+            if (name == "--verbose") {
+
+                options.verbose = std::stoi(value);
+
+            }
+            else if (name == "--seed") {
+
+                options.deterministicSeeding = true;
+                options.globalSeed = std::stol(value);
+
+            }
+            else if (name == "--event-offset") {
+
+                options.eventOffset = std::stol(value);
+
+            }
+            else if (name == "--cache") {
+
+                options.cacheDirectory = value;
+
+            }
+            else if (name == "--time-budget") {
+
+                options.timeBudget = std::stod(value);
+
+            }
+            else if (name == "--adaptive") {
+
+                options.adaptiveTolerance = std::stod(value);
+
+            }
+            else if (name == "--source") {
+
+                if (value == "pencil") options.sourceMode = SourceMode::Pencil;
+                else if (value == "point") options.sourceMode = SourceMode::Point;
+                else if (value == "beam") options.sourceMode = SourceMode::Beam;
+                else if (value == "field") options.sourceMode = SourceMode::Field;
+                else {
+
+                    G4Exception("B1::ParseRunOptions", "B1Options004", FatalException,
+                        ("Unknown source " + value + ", expected pencil, point, beam or field").c_str());
+
+                }
+
+            }
+            else if (name == "--source-distance") {
+
+                options.sourceDistance = std::stod(value) * cm;
+
+            }
+            else if (name == "--source-angle") {
+
+                options.sourceAngle = std::stod(value) * deg;
+
+            }
+            else if (name == "--direction-bins") {
+
+                options.directionBins = std::stoi(value);
+                if (options.directionBins <= 0) {
+
+                    G4Exception("B1::ParseRunOptions", "B1Options010", FatalException,
+                        "The number of direction bins must be positive");
+
+                }
+
+            }
+            else if (name == "--validate-field") {
+
+                options.validateField = ParseSwitch(name, value);
+
+            }
+            else if (name == "--light") {
+
+                options.lightModel = ParseSwitch(name, value);
+
+            }
+            else if (name == "--physics") {
+
+                options.emPhysics = value;
+
+            }
+            else if (name == "--performance") {
+
+                options.performanceLog = ParseSwitch(name, value);
+
+            }
+            else if (name == "--compare-physics") {
+
+                std::istringstream list(value);
+                std::string choice;
+                while (std::getline(list, choice, ',')) {
+
+                    if (!choice.empty()) options.comparePhysics.push_back(choice);
+
+                }
+
+            }
+            else if (name == "--threads") {
+
+                options.nThreads = std::stoi(value);
+
+            }
+            else if (name == "--record-steps") {
+
+                options.stepRecordFile = value;
+
+            }
+            else if (name == "--record-limit") {
+
+                options.stepRecordLimit = std::stol(value);
+
+            }
+            else if (name == "--record-events") {
+
+                options.eventRecordFile = value;
+
+            }
+            else if (name == "--record-events-limit") {
+
+                options.eventRecordLimit = std::stol(value);
+
+            }
+            else if (name == "--batches") {
+
+                options.nBatches = std::stoi(value);
+                if (options.nBatches < 0) {
+
+                    G4Exception("B1::ParseRunOptions", "B1Options008", FatalException,
+                        "The number of batches cannot be negative");
+
+                }
+
+            }
+            else if (name == "--sub-events") {
+
+                options.subEvents = ParseSwitch(name, value);
+
+            }
+            else if (name == "--sub-event-threshold") {
+
+                options.subEventThreshold = std::stod(value) * MeV;
+
+            }
+            else if (name == "--sub-event-size") {
+
+                options.subEventSize = std::stoi(value);
+
+            }
+            else {
+
+                G4Exception("B1::ParseRunOptions", "B1Options002", FatalException,
+                    ("Unknown option " + name).c_str());
+
+            }
+
+        }
+
+        if (options.timeBudget > 0. && options.adaptiveTolerance > 0.) {
+
+            G4Exception("B1::ParseRunOptions", "B1Options003", FatalException,
+                "--time-budget and --adaptive cannot be combined");
+
+        }
+
+        // Without --seed cached points cannot be topped up and rerun from
+        // scratch, which the event plan of the budget does not account for
+        if (options.timeBudget > 0. && !options.cacheDirectory.empty() && !options.deterministicSeeding) {
+
+            G4Exception("B1::ParseRunOptions", "B1Options009", FatalException,
+                "--time-budget with --cache needs --seed, so that cached events can be topped up");
+
+        }
+
+        // The comparison divides the total doses of the runs, which need the
+        // same events and energies for every constructor
+        if (!options.comparePhysics.empty() && (options.timeBudget > 0. || options.adaptiveTolerance > 0.)) {
+
+            G4Exception("B1::ParseRunOptions", "B1Options007", FatalException,
+                "--compare-physics needs fixed statistics and cannot be combined with --time-budget or --adaptive");
+
+        }
+
+        // The energies of a field sweep share one run, whose length is fixed
+        // before it starts, and the light tallies are not binned by energy
+        if (options.sourceMode == SourceMode::Field && (options.timeBudget > 0. || options.adaptiveTolerance > 0. || options.lightModel)) {
+
+            G4Exception("B1::ParseRunOptions", "B1Options011", FatalException,
+                "--source field cannot be combined with --time-budget, --adaptive or --light");
+
+        }
+
+        if (options.validateField && (options.sourceMode != SourceMode::Field || !options.comparePhysics.empty())) {
+
+            G4Exception("B1::ParseRunOptions", "B1Options012", FatalException,
+                "--validate-field needs --source field and cannot be combined with --compare-physics");
+
+        }
+
+        // Sub-events carry the deposits only, not the light emission, the steps
+        // or the event totals, which are only complete on the master
+        if (options.subEvents && (G4VERSION_NUMBER < 1120 || options.lightModel || !options.stepRecordFile.empty() || !options.eventRecordFile.empty())) {
+
+            G4Exception("B1::ParseRunOptions", "B1Options005", FatalException,
+                "--sub-events needs Geant4 11.2 or later and cannot be combined with --light, --record-steps or --record-events");
+
+        }
+
+        return options;
+
+    }
+
+    G4String SourceModeName(SourceMode mode){
+
+        switch (mode) {
+
+            case SourceMode::Point: return "point";
+            case SourceMode::Beam: return "beam";
+            case SourceMode::Field: return "field";
+            default: return "pencil";
+
+        }
+
+    }
+
+}
@@ -0,0 +1,631 @@
+/// \file B1/src/Simulation.cc
+/// \brief Implementation of the B1::Simulation class
+
+#include "Simulation.hh"
+
+#include "ActionInitialization.hh"
+#include "AdaptiveGrid.hh"
+#include "DetectorConstruction.hh"
+#include "DirectionalTally.hh"
+#include "EmPhysics.hh"
+#include "EventBudget.hh"
+#include "EventSeeding.hh"
+#include "LightModel.hh"
+#include "MemoryUsage.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "ResultCache.hh"
+#include "RunAction.hh"
+
+#include "G4Box.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4LossTableManager.hh"
+#include "G4Material.hh"
+#include "G4RunManagerFactory.hh"
+#include "G4StepLimiterPhysics.hh"
+#include "G4Tubs.hh"
+#include "G4UImanager.hh"
+#include "G4UnitsTable.hh"
+#include "G4VModularPhysicsList.hh"
+#include "G4Version.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace B1{
+
+    namespace {
+
+        // Material identity for the result cache key: name, density and mass fractions
+        std::string DescribeMaterial(const G4Material* material){
+
+            std::ostringstream description;
+            description << material->GetName() << "(" << std::hexfloat << material->GetDensity();
+            for (size_t i = 0; i < material->GetNumberOfElements(); ++i) {
+
+                description << "," << material->GetElement(i)->GetSymbol() << ":" << material->GetFractionVector()[i];
+
+            }
+            description << ")";
+            return description.str();
+
+        }
+
+        // Keep a margin of the wall-clock budget for the end of run bookkeeping
+        const G4double budgetSafety = 0.95;
+
+        // Sums of the energy of the given index of a field run: its direction
+        // bins, and the totals merged over them
+        DoseSums FieldEnergySums(const DoseSums& run, size_t index, G4int nDirectionBins){
+
+            const size_t binSize = DirectionalTally::fNValues;
+            auto first = run.directional.begin() + index * nDirectionBins * binSize;
+
+            DoseSums sums;
+            sums.directional.assign(first, first + nDirectionBins * binSize);
+
+            std::vector<G4double> total;
+            for (auto bin = sums.directional.begin(); bin != sums.directional.end(); bin += binSize) {
+
+                DirectionalTally::MergeBins(total, std::vector<G4double>(bin, bin + binSize));
+
+            }
+            sums.nEvents = static_cast<G4long>(total[0]);
+            sums.eDepGAGG = total[1];
+            sums.eDepM2GAGG = total[2];
+            sums.eDepPlastic = total[3];
+            sums.eDepM2Plastic = total[4];
+            return sums;
+
+        }
+
+    }
+
+    Simulation::Simulation(const SimulationConfig& config) : fConfig(config) {
+
+        const RunOptions& options = fConfig.options;
+
+        // RunManager
+        if (fConfig.interactive) {
+
+            fRunManager = G4RunManagerFactory::CreateRunManager(G4RunManagerType::SerialOnly);
+
+        }
+        else {
+
+            // The sub-event parallel mode is rejected by the option parser
+            // before Geant4 11.2
+#if G4VERSION_NUMBER >= 1120
+            if (options.subEvents) {
+
+                fRunManager = G4RunManagerFactory::CreateRunManager(G4RunManagerType::SubEvt);
+                fRunManager->RegisterSubEventType(0, options.subEventSize);
+
+            }
+#endif
+            if (!fRunManager) fRunManager = G4RunManagerFactory::CreateRunManager(G4RunManagerType::Default);
+            if (options.nThreads > 0) fRunManager->SetNumberOfThreads(options.nThreads);
+
+        }
+
+        // DetectorConstruction
+        fDetectorConstruction = new DetectorConstruction();
+        ConfigureGeometry();
+        fRunManager->SetUserInitialization(fDetectorConstruction);
+
+        // Physics list
+        fPhysicsList = new G4VModularPhysicsList();
+        G4LossTableManager::Instance();
+        fPhysicsList->SetDefaultCutValue(0.01*mm);
+        fPhysicsList->RegisterPhysics(CreateEmPhysics(options.emPhysics));
+        fPhysicsName = EmPhysicsClassName(options.emPhysics) + "+G4StepLimiterPhysics";
+        G4StepLimiterPhysics* stepLimitPhys = new G4StepLimiterPhysics();
+        stepLimitPhys->SetApplyToAll(true);
+        fPhysicsList->RegisterPhysics(stepLimitPhys);
+        fRunManager->SetUserInitialization(fPhysicsList);
+
+        // ActionInitialization
+        fRunManager->SetUserInitialization(new ActionInitialization(options));
+        if (fConfig.options.verbose > 0) PrintMemoryUsage("before initialisation", fRunManager->GetNumberOfThreads());
+        SetMemoryBaseline();
+        fRunManager->Initialize();
+        if (fConfig.options.verbose > 0) PrintMemoryUsage("after initialisation", fRunManager->GetNumberOfThreads());
+
+        OpenCache();
+
+    }
+
+    Simulation::~Simulation(){
+
+        delete fRunManager;
+
+    }
+
+    void Simulation::SetGeometry(const GeometryConfig& geometry){
+
+        fConfig.geometry = geometry;
+        ConfigureGeometry();
+
+        // Only the geometry is rebuilt, the physics tables are kept
+        fRunManager->ReinitializeGeometry(true);
+        fRunManager->Initialize();
+        OpenCache();
+
+    }
+
+    void Simulation::ConfigureGeometry(){
+
+        const GeometryConfig& geometry = fConfig.geometry;
+        const RunOptions& options = fConfig.options;
+
+        fDetectorConstruction->SetPlasticDimensions(geometry.plasticDiameter, geometry.plasticSizeZ);
+        fDetectorConstruction->SetGAAGDimensions(geometry.gaggSizeX, geometry.gaggSizeY, geometry.gaggSizeZ);
+
+        // Room for every start point of the source in the world
+        fDetectorConstruction->SetSourceExtent(PrimaryGeneratorAction::SourceExtent(options, 0.5 * geometry.plasticDiameter, 0.5 * geometry.plasticSizeZ));
+
+    }
+
+    void Simulation::OpenCache(){
+
+        const RunOptions& options = fConfig.options;
+        if (options.cacheDirectory.empty()) return;
+
+        // Result cache keyed by everything that determines the sums
+        G4LogicalVolume* gaggLV = fDetectorConstruction->GetScoringVolumeGAGG();
+        auto gaggSolid = dynamic_cast<G4Box*>(gaggLV->GetSolid());
+        G4LogicalVolume* plasticLV = fDetectorConstruction->GetScoringVolumePlastic();
+        auto plasticSolid = dynamic_cast<G4Tubs*>(plasticLV->GetSolid());
+
+        std::ostringstream configuration;
+        configuration << "geant4=" << G4Version << "/" << G4VERSION_NUMBER
+            << ";physics=" << fPhysicsName
+            << ";cut=" << std::hexfloat << fPhysicsList->GetDefaultCutValue()
+            << ";gagg=" << 2. * gaggSolid->GetXHalfLength() << "," << 2. * gaggSolid->GetYHalfLength() << "," << 2. * gaggSolid->GetZHalfLength() << "," << DescribeMaterial(gaggLV->GetMaterial())
+            << ";plastic=" << plasticSolid->GetOuterRadius() << "," << 2. * plasticSolid->GetZHalfLength() << "," << DescribeMaterial(plasticLV->GetMaterial())
+            << ";world=" << DescribeMaterial(G4LogicalVolumeStore::GetInstance()->GetVolume("World")->GetMaterial())
+            << ";source=gamma," << SourceModeName(options.sourceMode) << "," << options.sourceDistance << "," << options.sourceAngle;
+        if (options.lightModel) {
+
+            configuration << ";light=" << LightModel::fNBins << "," << LightModel::fBinWidth;
+
+        }
+        if (options.sourceMode == SourceMode::Field) {
+
+            configuration << ";directions=" << options.directionBins;
+
+        }
+        if (options.deterministicSeeding) {
+
+            configuration << ";seed=" << options.globalSeed << "," << options.eventOffset;
+
+        }
+
+        fCache = std::make_unique<ResultCache>(options.cacheDirectory, configuration.str());
+        fCached.clear();
+
+    }
+
+    G4bool Simulation::LookupCache(G4double energy, DoseSums& sums){
+
+        if (!fCache || !fCache->Lookup(energy, sums)) return false;
+
+        fCached.insert(energy);
+        return true;
+
+    }
+
+    G4double Simulation::GetGAGGMass() const{
+
+        return fDetectorConstruction->GetScoringVolumeGAGG()->GetMass();
+
+    }
+
+    G4double Simulation::GetPlasticMass() const{
+
+        return fDetectorConstruction->GetScoringVolumePlastic()->GetMass() - GetGAGGMass();
+
+    }
+
+    G4double Simulation::GetSourceWeight() const{
+
+        const GeometryConfig& geometry = fConfig.geometry;
+        return PrimaryGeneratorAction::GeometricWeight(fConfig.options, 0.5 * geometry.plasticDiameter, 0.5 * geometry.plasticSizeZ);
+
+    }
+
+    G4double Simulation::TopUp(G4double energy, DoseSums& sums, G4long targetEvents){
+
+        auto UImanager = G4UImanager::GetUIpointer();
+
+        UImanager->ApplyCommand("/gun/particle gamma");
+        std::ostringstream energyCmd;
+        energyCmd << "/gun/energy " << G4BestUnit(energy, "Energy");
+        if (fConfig.options.verbose > 0) G4cout << energyCmd.str() << G4endl;
+        UImanager->ApplyCommand(energyCmd.str());
+
+        G4long nEventsToRun = targetEvents - sums.nEvents;
+
+        // Without --seed every process starts from the same engine state, so a
+        // top-up of cached sums would replay the histories already in them
+        if (nEventsToRun > 0 && fCached.count(energy) && !fConfig.options.deterministicSeeding) {
+
+            G4cout
+            << G4endl
+            << "Not topping up the " << sums.nEvents << " cached events at " << G4BestUnit(energy, "Energy")
+            << " without --seed, running the point from scratch"
+            << G4endl;
+
+            sums = DoseSums();
+            nEventsToRun = targetEvents;
+
+        }
+
+        if (nEventsToRun <= 0) {
+
+            G4cout
+            << G4endl
+            << "------------------------------------------------------------"
+            << G4endl
+            << "Using " << sums.nEvents << " available gammas of energy " << G4BestUnit(energy, "Energy")
+            << G4endl;
+
+            return 0.;
+
+        }
+
+        std::ostringstream beamOnCmd;
+        beamOnCmd << "/run/beamOn " << nEventsToRun;
+
+        G4cout
+        << G4endl
+        << "------------------------------------------------------------"
+        << G4endl
+        << "The run consists of " << nEventsToRun << " gammas of energy " << G4BestUnit(energy, "Energy");
+        if (sums.nEvents > 0) G4cout << " (topping up " << sums.nEvents << " available events)";
+        G4cout << G4endl;
+
+        // Continue the event numbering of the statistics already available
+        auto runStart = std::chrono::steady_clock::now();
+        SetRunEventOffset(sums.nEvents);
+        UImanager->ApplyCommand(beamOnCmd.str());
+        SetRunEventOffset(0);
+        auto runEnd = std::chrono::steady_clock::now();
+        std::chrono::duration<G4double> runTime = runEnd - runStart;
+
+        const auto masterRunAction = static_cast<const RunAction*>(fRunManager->GetUserRunAction());
+        sums.Merge(masterRunAction->GetDoseSums());
+
+        // Thread time not spent in events, and the time from the first
+        // thread running out of events to the end of the run
+        RunRecord record;
+        record.nEvents = nEventsToRun;
+        record.wallTime = runTime.count();
+        record.nSteps = masterRunAction->GetNumberOfSteps();
+        G4int nTrackingThreads = fRunManager->GetNumberOfThreads() + (fConfig.options.subEvents ? 1 : 0);
+        record.busyTime = masterRunAction->GetBusyTime();
+        record.idleTime = std::max(nTrackingThreads * record.wallTime - record.busyTime, 0.);
+        std::chrono::duration<G4double> runEndTime = runEnd.time_since_epoch();
+        record.tailTime = std::max(runEndTime.count() - masterRunAction->GetFirstIdleTime(), 0.);
+        G4cout << "Thread idle time " << record.idleTime << " s of " << nTrackingThreads * record.wallTime
+            << " s, first thread idle " << record.tailTime << " s before the end of the run" << G4endl;
+        fRuns[energy].push_back(record);
+
+        sums.seconds += record.wallTime;
+        sums.nSteps += record.nSteps;
+        if (fCache) fCache->Store(energy, sums);
+        fCached.erase(energy);
+
+        return record.wallTime;
+
+    }
+
+    PointResult Simulation::MakeResult(G4double energy, const DoseSums& sums){
+
+        PointResult result;
+        result.energy = energy;
+
+        // Geometric weight of the source
+        result.sums = sums;
+        result.sums.Scale(GetSourceWeight());
+
+        result.eDepGAGG = result.sums.eDepGAGG;
+        result.rmsEDepGAGG = result.sums.RmsEDepGAGG();
+        result.eDepPlastic = result.sums.eDepPlastic;
+        result.rmsEDepPlastic = result.sums.RmsEDepPlastic();
+
+        G4double gaggMass = GetGAGGMass();
+        G4double plasticMass = GetPlasticMass();
+        result.doseGAGG = result.eDepGAGG / gaggMass;
+        result.rmsDoseGAGG = result.rmsEDepGAGG / gaggMass;
+        result.dosePlastic = result.eDepPlastic / plasticMass;
+        result.rmsDosePlastic = result.rmsEDepPlastic / plasticMass;
+
+        auto runs = fRuns.find(energy);
+        if (runs != fRuns.end()) {
+
+            result.runs = std::move(runs->second);
+            fRuns.erase(runs);
+
+        }
+
+        // A point served from the cache reports the cost of its cached sums
+        if (fCached.erase(energy)) {
+
+            RunRecord record;
+            record.nEvents = sums.nEvents;
+            record.wallTime = sums.seconds;
+            record.nSteps = sums.nSteps;
+            record.cached = true;
+            result.runs.insert(result.runs.begin(), record);
+
+        }
+
+        return result;
+
+    }
+
+    std::vector<DoseSums> Simulation::RunField(const std::vector<G4double>& energies, G4long nEvents){
+
+        auto UImanager = G4UImanager::GetUIpointer();
+        UImanager->ApplyCommand("/gun/particle gamma");
+
+        G4long nEventsToRun = nEvents * static_cast<G4long>(energies.size());
+        std::ostringstream beamOnCmd;
+        beamOnCmd << "/run/beamOn " << nEventsToRun;
+
+        G4cout
+        << G4endl
+        << "------------------------------------------------------------"
+        << G4endl
+        << "The run consists of " << nEvents << " gammas of each of " << energies.size() << " energies from "
+        << G4BestUnit(energies.front(), "Energy") << " to " << G4BestUnit(energies.back(), "Energy")
+        << G4endl;
+
+        auto runStart = std::chrono::steady_clock::now();
+        PrimaryGeneratorAction::SetFieldEnergies(energies);
+        UImanager->ApplyCommand(beamOnCmd.str());
+        PrimaryGeneratorAction::SetFieldEnergies({});
+        auto runEnd = std::chrono::steady_clock::now();
+        std::chrono::duration<G4double> runTime = runEnd - runStart;
+
+        const auto masterRunAction = static_cast<const RunAction*>(fRunManager->GetUserRunAction());
+        const DoseSums& run = masterRunAction->GetDoseSums();
+
+        // The energies share the run in equal numbers of events, the cost of
+        // each one alone is not measured
+        G4double share = 1. / energies.size();
+        RunRecord record;
+        record.nEvents = nEvents;
+        record.wallTime = share * runTime.count();
+        record.nSteps = static_cast<G4long>(share * masterRunAction->GetNumberOfSteps());
+        G4int nTrackingThreads = fRunManager->GetNumberOfThreads() + (fConfig.options.subEvents ? 1 : 0);
+        record.busyTime = share * masterRunAction->GetBusyTime();
+        record.idleTime = std::max(nTrackingThreads * record.wallTime - record.busyTime, 0.);
+        std::chrono::duration<G4double> runEndTime = runEnd.time_since_epoch();
+        record.tailTime = share * std::max(runEndTime.count() - masterRunAction->GetFirstIdleTime(), 0.);
+
+        std::vector<DoseSums> sums;
+        for (size_t i = 0; i < energies.size(); ++i) {
+
+            sums.push_back(FieldEnergySums(run, i, fConfig.options.directionBins));
+            sums.back().seconds = record.wallTime;
+            sums.back().nSteps = record.nSteps;
+            fRuns[energies[i]].push_back(record);
+
+        }
+        return sums;
+
+    }
+
+    PointResult Simulation::RunPoint(G4double energy, G4long nEvents){
+
+        DoseSums sums;
+        LookupCache(energy, sums);
+        TopUp(energy, sums, nEvents);
+        return MakeResult(energy, sums);
+
+    }
+
+    std::vector<PointResult> Simulation::Sweep(const std::vector<G4double>& energies, G4long nEvents, const PointCallback& callback){
+
+        // The time budget covers the sweep, not the set-up before it
+        auto sweepStart = std::chrono::steady_clock::now();
+
+        const RunOptions& options = fConfig.options;
+        std::vector<PointResult> results;
+        auto report = [&](G4double energy, const DoseSums& sums) {
+
+            results.push_back(MakeResult(energy, sums));
+            if (callback) callback(results.back());
+
+        };
+
+        // Reuse earlier results of the same configuration when cached
+        std::vector<DoseSums> sums(energies.size());
+        for (size_t i = 0; i < energies.size(); ++i) LookupCache(energies[i], sums[i]);
+
+        // The field source runs the missing energies together, which numbers
+        // their events from zero, so cached points short of the statistics
+        // are run again from scratch instead of being topped up
+        if (options.sourceMode == SourceMode::Field) {
+
+            std::vector<G4double> missing;
+            for (size_t i = 0; i < energies.size(); ++i) {
+
+                if (sums[i].nEvents >= nEvents) {
+
+                    G4cout << "Using " << sums[i].nEvents << " available gammas of energy " << G4BestUnit(energies[i], "Energy") << G4endl;
+                    continue;
+
+                }
+                if (fCached.erase(energies[i])) {
+
+                    G4cout << "Running the " << sums[i].nEvents << " cached events at " << G4BestUnit(energies[i], "Energy") << " again with the field run" << G4endl;
+
+                }
+                missing.push_back(energies[i]);
+
+            }
+
+            std::vector<DoseSums> runSums;
+            if (!missing.empty()) runSums = RunField(missing, nEvents);
+
+            for (size_t i = 0, j = 0; i < energies.size(); ++i) {
+
+                if (j < missing.size() && missing[j] == energies[i]) {
+
+                    sums[i] = runSums[j++];
+                    if (fCache) fCache->Store(energies[i], sums[i]);
+
+                }
+                report(energies[i], sums[i]);
+
+            }
+            return results;
+
+        }
+
+        // Fixed statistics, the pilot pass of a budgeted sweep or the coarse
+        // grid of an adaptive one
+        G4bool budgeted = options.timeBudget > 0.;
+        G4bool adaptive = options.adaptiveTolerance > 0.;
+        std::vector<PilotEstimate> pilots(energies.size());
+        for (size_t i = 0; i < energies.size(); ++i) {
+
+            G4long nAvailable = sums[i].nEvents;
+            G4double seconds = TopUp(energies[i], sums[i], nEvents);
+
+            pilots[i].nEvents = sums[i].nEvents;
+            pilots[i].relativeVariance = RelativeVariance(sums[i]);
+            if (sums[i].nEvents > nAvailable) pilots[i].secondsPerEvent = seconds / (sums[i].nEvents - nAvailable);
+
+            if (!budgeted && !adaptive) report(energies[i], sums[i]);
+
+        }
+
+        if (budgeted) {
+
+            // Points served entirely from the cache cost as much as the average
+            G4double measuredSeconds = 0.;
+            G4int nMeasured = 0;
+            for (const auto& pilot : pilots) {
+
+                if (pilot.secondsPerEvent <= 0.) continue;
+                measuredSeconds += pilot.secondsPerEvent;
+                ++nMeasured;
+
+            }
+            for (auto& pilot : pilots) {
+
+                if (pilot.secondsPerEvent <= 0. && nMeasured > 0) pilot.secondsPerEvent = measuredSeconds / nMeasured;
+
+            }
+
+            // Keep a margin for the end of run bookkeeping of every point
+            std::chrono::duration<G4double> elapsed = std::chrono::steady_clock::now() - sweepStart;
+            G4double secondsLeft = budgetSafety * (options.timeBudget - elapsed.count());
+            std::vector<G4long> plan = AllocateEvents(pilots, std::max(secondsLeft, 0.));
+
+            G4cout << G4endl << "Event plan for " << secondsLeft << " s left of the " << options.timeBudget << " s budget:" << G4endl;
+            for (size_t i = 0; i < energies.size(); ++i) {
+
+                G4cout << "  " << G4BestUnit(energies[i], "Energy") << ": " << plan[i] << " events" << G4endl;
+
+            }
+
+            for (size_t i = 0; i < energies.size(); ++i) {
+
+                TopUp(energies[i], sums[i], plan[i]);
+                report(energies[i], sums[i]);
+
+            }
+
+            // Achieved uncertainties
+            std::chrono::duration<G4double> total = std::chrono::steady_clock::now() - sweepStart;
+            G4cout << G4endl << "Budgeted sweep finished after " << total.count() << " s:" << G4endl;
+            for (size_t i = 0; i < energies.size(); ++i) {
+
+                G4cout << "  " << G4BestUnit(energies[i], "Energy") << ": " << sums[i].nEvents << " events"
+                    << ", relative uncertainty GAGG = " << (sums[i].eDepGAGG > 0. ? sums[i].RmsEDepGAGG() / sums[i].eDepGAGG : 0.)
+                    << ", plastic = " << (sums[i].eDepPlastic > 0. ? sums[i].RmsEDepPlastic() / sums[i].eDepPlastic : 0.)
+                    << G4endl;
+
+            }
+
+        }
+
+        if (adaptive) {
+
+            std::vector<GridPoint> grid(energies.size());
+            for (size_t i = 0; i < energies.size(); ++i) {
+
+                grid[i].energy = energies[i];
+                grid[i].logEnergy = std::log10(energies[i] / MeV);
+                grid[i].sums = sums[i];
+
+            }
+
+            // Intervals are halved down to 1/64 of the coarse step at most
+            G4double coarseStep = energies.size() > 1 ? grid[1].logEnergy - grid[0].logEnergy : 0.;
+            const G4double minLogStep = coarseStep / 64.;
+            auto refinable = [&](size_t a, size_t b) { return grid[b].logEnergy - grid[a].logEnergy >= 2. * minLogStep; };
+
+            while (true) {
+
+                // Point whose neighbours interpolate it worst
+                size_t worst = 0;
+                G4double worstSignificance = options.adaptiveTolerance;
+                for (size_t j = 1; j + 1 < grid.size(); ++j) {
+
+                    if (!refinable(j - 1, j) && !refinable(j, j + 1)) continue;
+
+                    G4double significance = InterpolationSignificance(grid[j - 1], grid[j], grid[j + 1]);
+                    if (significance > worstSignificance) {
+
+                        worst = j;
+                        worstSignificance = significance;
+
+                    }
+
+                }
+                if (worst == 0) break;
+
+                G4cout << G4endl << "Refining around " << G4BestUnit(grid[worst].energy, "Energy")
+                    << " (interpolation off by " << worstSignificance << " sigma)" << G4endl;
+
+                // Split both neighbouring intervals
+                std::vector<GridPoint> inserted;
+                for (size_t a : {worst - 1, worst}) {
+
+                    if (!refinable(a, a + 1)) continue;
+
+                    GridPoint point;
+                    point.logEnergy = 0.5 * (grid[a].logEnergy + grid[a + 1].logEnergy);
+                    point.energy = std::pow(10, point.logEnergy) * MeV;
+                    LookupCache(point.energy, point.sums);
+                    TopUp(point.energy, point.sums, nEvents);
+                    inserted.push_back(point);
+
+                }
+                for (const auto& point : inserted) {
+
+                    auto position = std::lower_bound(grid.begin(), grid.end(), point,
+                        [](const GridPoint& x, const GridPoint& y) { return x.logEnergy < y.logEnergy; });
+                    grid.insert(position, point);
+
+                }
+
+            }
+
+            G4cout << G4endl << "Adaptive sweep converged with " << grid.size() << " energy points" << G4endl;
+            for (const auto& point : grid) report(point.energy, point.sums);
+
+        }
+
+        return results;
+
+    }
+
+}
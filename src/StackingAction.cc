@@ -0,0 +1,32 @@
+/// \file B1/src/StackingAction.cc
+/// \brief Implementation of the B1::StackingAction class
+
+#include "StackingAction.hh"
+
+#include "G4Threading.hh"
+#include "G4Track.hh"
+#include "G4Version.hh"
+
+namespace B1{
+
+    StackingAction::StackingAction(G4double threshold) : fThreshold(threshold) {}
+
+    G4ClassificationOfNewTrack StackingAction::ClassifyNewTrack(const G4Track* track){
+
+        if (track->GetParentID() == 0) {
+
+            fSplit = track->GetKineticEnergy() >= fThreshold;
+            return fUrgent;
+
+        }
+
+        // Workers track their sub-events to the end
+#if G4VERSION_NUMBER >= 1120
+        if (fSplit && G4Threading::IsMasterThread()) return fSubEvent_0;
+#endif
+
+        return fUrgent;
+
+    }
+
+}
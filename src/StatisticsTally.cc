@@ -0,0 +1,79 @@
+/// \file B1/src/StatisticsTally.cc
+/// \brief Implementation of the B1::StatisticsTally class
+
+#include "StatisticsTally.hh"
+#include "ExactSum.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace B1{
+
+    StatisticsTally::StatisticsTally(const G4String& name, G4int nBatches)
+        : G4VAccumulable(name), fBatchEvents(nBatches, 0), fBatchGAGG(nBatches, 0), fBatchPlastic(nBatches, 0) {}
+
+    void StatisticsTally::Add(G4int eventID, G4double eDepGAGG, G4double eDepPlastic){
+
+        fGAGG.Add(eDepGAGG);
+        fPlastic.Add(eDepPlastic);
+
+        if (fBatchEvents.empty() || fRunLength <= 0) return;
+
+        G4long nBatches = fBatchEvents.size();
+        G4long batch = std::min(static_cast<G4long>(eventID) * nBatches / fRunLength, nBatches - 1);
+        ++fBatchEvents[batch];
+        fBatchGAGG[batch] += std::llround(eDepGAGG / ExactSum::fQuantum);
+        fBatchPlastic[batch] += std::llround(eDepPlastic / ExactSum::fQuantum);
+
+    }
+
+    void StatisticsTally::Merge(const G4VAccumulable& other){
+
+        const auto& otherTally = static_cast<const StatisticsTally&>(other);
+        fGAGG.Merge(otherTally.fGAGG);
+        fPlastic.Merge(otherTally.fPlastic);
+        for (size_t i = 0; i < fBatchEvents.size(); ++i) {
+
+            fBatchEvents[i] += otherTally.fBatchEvents[i];
+            fBatchGAGG[i] += otherTally.fBatchGAGG[i];
+            fBatchPlastic[i] += otherTally.fBatchPlastic[i];
+
+        }
+
+    }
+
+    void StatisticsTally::Reset(){
+
+        fGAGG = StreamingStats();
+        fPlastic = StreamingStats();
+        fBatchEvents.assign(fBatchEvents.size(), 0);
+        fBatchGAGG.assign(fBatchGAGG.size(), 0);
+        fBatchPlastic.assign(fBatchPlastic.size(), 0);
+
+    }
+
+#if G4VERSION_NUMBER >= 1130
+    void StatisticsTally::Print(G4PrintOptions) const{
+
+        G4cout << GetName() << ": " << fGAGG.n << " events, mean GAGG " << fGAGG.mean << " +- " << fGAGG.StandardError()
+            << ", mean plastic " << fPlastic.mean << " +- " << fPlastic.StandardError() << G4endl;
+
+    }
+#endif
+
+    std::vector<G4double> StatisticsTally::GetBatches() const{
+
+        std::vector<G4double> batches;
+        for (size_t i = 0; i < fBatchEvents.size(); ++i) {
+
+            if (fBatchEvents[i] == 0) continue;
+            batches.push_back(fBatchEvents[i]);
+            batches.push_back(static_cast<G4double>(static_cast<long double>(fBatchGAGG[i]) * ExactSum::fQuantum));
+            batches.push_back(static_cast<G4double>(static_cast<long double>(fBatchPlastic[i]) * ExactSum::fQuantum));
+
+        }
+        return batches;
+
+    }
+
+}
@@ -0,0 +1,87 @@
+/// \file B1/src/StepRecorder.cc
+/// \brief Implementation of the B1::StepRecorder class
+
+#include "StepRecorder.hh"
+
+#include "G4AutoLock.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+
+namespace B1{
+
+    namespace {
+
+        G4Mutex recorderMutex = G4MUTEX_INITIALIZER;
+        std::unique_ptr<std::ofstream> recorderFile;
+        G4long recordedSteps = 0;
+        G4bool recordingFull = false;
+
+    }
+
+    StepRecorder::StepRecorder(const G4String& fileName, G4long maxSteps)
+        : fFileName(fileName), fMaxSteps(maxSteps) {}
+
+    void StepRecorder::EndOfEvent(){
+
+        if (fEventSteps.empty()) return;
+
+        G4AutoLock lock(&recorderMutex);
+
+        if (!recordingFull && recordedSteps + static_cast<G4long>(fEventSteps.size()) > fMaxSteps) {
+
+            recordingFull = true;
+            if (recorderFile) recorderFile->flush();
+
+        }
+
+        if (!recordingFull) {
+
+            if (!recorderFile) {
+
+                recorderFile = std::make_unique<std::ofstream>(fFileName, std::ios::binary);
+                recorderFile->write(fMagic, sizeof(fMagic));
+
+            }
+
+            auto nSteps = static_cast<std::uint32_t>(fEventSteps.size());
+            recorderFile->write(reinterpret_cast<const char*>(&nSteps), sizeof(nSteps));
+            recorderFile->write(reinterpret_cast<const char*>(fEventSteps.data()), nSteps * sizeof(StepRecord));
+            recordedSteps += nSteps;
+
+        }
+        fFull = recordingFull;
+
+        lock.unlock();
+        fEventSteps.clear();
+
+    }
+
+    G4bool StepRecorder::Read(const G4String& fileName, std::vector<StepRecord>& steps, std::vector<std::uint32_t>& eventSizes){
+
+        std::ifstream file(fileName, std::ios::binary);
+
+        char magic[sizeof(fMagic)];
+        if (!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), fMagic)) return false;
+
+        std::uint32_t nSteps = 0;
+        while (file.read(reinterpret_cast<char*>(&nSteps), sizeof(nSteps))) {
+
+            size_t first = steps.size();
+            steps.resize(first + nSteps);
+            if (!file.read(reinterpret_cast<char*>(steps.data() + first), nSteps * sizeof(StepRecord))) {
+
+                steps.resize(first);
+                break;
+
+            }
+            eventSizes.push_back(nSteps);
+
+        }
+
+        return true;
+
+    }
+
+}
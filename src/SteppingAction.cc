@@ -5,33 +5,32 @@
 
 #include "DetectorConstruction.hh"
 #include "EventAction.hh"
+#include "StepRecorder.hh"
 
 #include "G4Event.hh"
 #include "G4LogicalVolume.hh"
 #include "G4RunManager.hh"
 #include "G4Step.hh"
+#include "G4Track.hh"
 
 namespace B1{
 
-    SteppingAction::SteppingAction(EventAction* eventAction) : fEventAction(eventAction) {}
+    SteppingAction::SteppingAction(EventAction* eventAction)
+        : fEventAction(eventAction), fLightEnabled(eventAction->IsLightEnabled()),
+          fStepRecorder(eventAction->GetStepRecorder()) {}
 
     void SteppingAction::UserSteppingAction(const G4Step* step){
 
-        if (!fScoringVolumeGAGG) {
+        // Scoring volumes, looked up again when the geometry was rebuilt
+        G4int geometryVersion = DetectorConstruction::GetGeometryVersion();
+        if (geometryVersion != fGeometryVersion) {
 
             const auto detConstruction = static_cast<const DetectorConstruction*>(
                 G4RunManager::GetRunManager()->GetUserDetectorConstruction()
             );
             fScoringVolumeGAGG = detConstruction->GetScoringVolumeGAGG();
-
-        }
-
-        if (!fScoringVolumePlastic) {
-
-            const auto detConstruction = static_cast<const DetectorConstruction*>(
-                G4RunManager::GetRunManager()->GetUserDetectorConstruction()
-            );
             fScoringVolumePlastic = detConstruction->GetScoringVolumePlastic();
+            fGeometryVersion = geometryVersion;
 
         }
 
@@ -39,8 +38,36 @@ namespace B1{
         G4LogicalVolume* volume =
             step->GetPreStepPoint()->GetTouchableHandle()->GetVolume()->GetLogicalVolume();
 
-        // Collect energy deposition
         G4double eDepStep = step->GetTotalEnergyDeposit();
+        G4double stepLength = step->GetStepLength();
+        G4double time = step->GetPreStepPoint()->GetGlobalTime();
+
+        if (fStepRecorder) {
+
+            StepRecord record;
+            record.volume = (volume == fScoringVolumeGAGG) ? 2 : (volume == fScoringVolumePlastic) ? 1 : 0;
+            record.pdgCode = step->GetTrack()->GetDefinition()->GetPDGEncoding();
+            record.trackID = step->GetTrack()->GetTrackID();
+            record.parentID = step->GetTrack()->GetParentID();
+            record.eDep = eDepStep;
+            record.x = step->GetPreStepPoint()->GetPosition().x();
+            record.y = step->GetPreStepPoint()->GetPosition().y();
+            record.z = step->GetPreStepPoint()->GetPosition().z();
+            record.stepLength = stepLength;
+            record.time = time;
+            fStepRecorder->Record(record);
+
+        }
+
+        Score(volume, eDepStep, stepLength, time);
+
+    }
+
+    void SteppingAction::Score(const G4LogicalVolume* volume, G4double eDepStep, G4double stepLength, G4double time){
+
+        fEventAction->CountStep();
+
+        // Collect energy deposition
         if (volume != fScoringVolumeGAGG) {
 
             if (volume != fScoringVolumePlastic) {
@@ -50,10 +77,28 @@ namespace B1{
             }
 
             fEventAction->AddEDepPlastic(eDepStep);
+            if (fLightEnabled) {
+
+                fEventAction->AddLightPlastic(eDepStep, stepLength, time);
+
+            }
             return;
         }
         
         fEventAction->AddEDepGAGG(eDepStep);
+        if (fLightEnabled) {
+
+            fEventAction->AddLightGAGG(eDepStep, stepLength, time);
+
+        }
+
+    }
+
+    void SteppingAction::SetScoringVolumes(G4LogicalVolume* plastic, G4LogicalVolume* gagg){
+
+        fScoringVolumePlastic = plastic;
+        fScoringVolumeGAGG = gagg;
+        fGeometryVersion = DetectorConstruction::GetGeometryVersion();
 
     }
 
@@ -0,0 +1,97 @@
+/// \file B1/src/StreamingStats.cc
+/// \brief Implementation of the B1::StreamingStats structure
+
+#include "StreamingStats.hh"
+
+#include <cmath>
+
+namespace B1{
+
+    void StreamingStats::Add(G4double value){
+
+        G4double n1 = n;
+        ++n;
+        G4double delta = value - mean;
+        G4double deltaN = delta / n;
+        G4double deltaN2 = deltaN * deltaN;
+        G4double term = delta * deltaN * n1;
+
+        mean += deltaN;
+        m4 += term * deltaN2 * (1. * n * n - 3. * n + 3.) + 6. * deltaN2 * m2 - 4. * deltaN * m3;
+        m3 += term * deltaN * (n - 2.) - 3. * deltaN * m2;
+        m2 += term;
+
+    }
+
+    void StreamingStats::Merge(const StreamingStats& other){
+
+        if (other.n == 0) return;
+        if (n == 0) {
+
+            *this = other;
+            return;
+
+        }
+
+        G4double na = n;
+        G4double nb = other.n;
+        G4double nab = na + nb;
+        G4double delta = other.mean - mean;
+        G4double delta2 = delta * delta;
+
+        G4double mergedM4 = m4 + other.m4
+            + delta2 * delta2 * na * nb * (na * na - na * nb + nb * nb) / (nab * nab * nab)
+            + 6. * delta2 * (na * na * other.m2 + nb * nb * m2) / (nab * nab)
+            + 4. * delta * (na * other.m3 - nb * m3) / nab;
+        G4double mergedM3 = m3 + other.m3
+            + delta2 * delta * na * nb * (na - nb) / (nab * nab)
+            + 3. * delta * (na * other.m2 - nb * m2) / nab;
+        G4double mergedM2 = m2 + other.m2 + delta2 * na * nb / nab;
+
+        n += other.n;
+        mean += delta * nb / nab;
+        m2 = mergedM2;
+        m3 = mergedM3;
+        m4 = mergedM4;
+
+    }
+
+    void StreamingStats::Scale(G4double weight){
+
+        G4double weight2 = weight * weight;
+        mean *= weight;
+        m2 *= weight2;
+        m3 *= weight2 * weight;
+        m4 *= weight2 * weight2;
+
+    }
+
+    G4double StreamingStats::StandardError() const{
+
+        if (n < 2) return 0.;
+        return std::sqrt(Variance() / n);
+
+    }
+
+    G4double StreamingStats::VarianceOfVariance() const{
+
+        if (m2 <= 0.) return 0.;
+        return m4 / (m2 * m2) - 1. / n;
+
+    }
+
+    G4double StreamingStats::Skewness() const{
+
+        if (m2 <= 0.) return 0.;
+        return std::sqrt(1. * n) * m3 / std::pow(m2, 1.5);
+
+    }
+
+    G4double StreamingStats::ExcessKurtosis() const{
+
+        if (m2 <= 0.) return 0.;
+        return n * m4 / (m2 * m2) - 3.;
+
+    }
+
+}
@@ -0,0 +1,14 @@
+/// \file B1/src/SubEventDeposits.cc
+/// \brief Implementation of the B1::SubEventDeposits class
+
+#include "SubEventDeposits.hh"
+
+namespace B1{
+
+    void SubEventDeposits::Print() const{
+
+        G4cout << "Sub-event deposits: GAGG " << fEDepGAGG << ", plastic " << fEDepPlastic << ", " << fNSteps << " steps" << G4endl;
+
+    }
+
+}
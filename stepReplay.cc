@@ -0,0 +1,202 @@
+/// \file stepReplay.cc
+/// \brief Replay benchmark of the B1 scoring code on recorded steps
+///
+/// Usage: stepReplay <recording> [repetitions] [--light on|off]
+/// The recording is written by exampleB1 with --record-steps. Steps are
+/// fed from memory through SteppingAction::UserSteppingAction, with the
+/// touchable of their volume on the pre-step point, and the event and run
+/// actions, without any transport, and the cost per step is reported.
+
+#include "DetectorConstruction.hh"
+#include "EventAction.hh"
+#include "LightModel.hh"
+#include "RunAction.hh"
+#include "RunOptions.hh"
+#include "StepRecorder.hh"
+#include "SteppingAction.hh"
+
+#include "G4Event.hh"
+#include "G4Exception.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4Navigator.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4TouchableHandle.hh"
+#include "G4UnitsTable.hh"
+#include "G4VPhysicalVolume.hh"
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+using namespace B1;
+
+int main(int argc, char** argv){
+
+    if (argc < 2) {
+
+        G4cerr << "Usage: " << argv[0] << " <recording> [repetitions] [--light on|off]" << G4endl;
+        return 1;
+
+    }
+
+    std::vector<StepRecord> steps;
+    std::vector<std::uint32_t> eventSizes;
+    if (!StepRecorder::Read(argv[1], steps, eventSizes) || eventSizes.empty()) {
+
+        G4cerr << "No recorded steps in " << argv[1] << G4endl;
+        return 1;
+
+    }
+
+    // Scored volumes of the records index the volume table below
+    for (const auto& step : steps) {
+
+        if (step.volume < 0 || step.volume > 2) {
+
+            G4cerr << "Invalid volume " << step.volume << " in " << argv[1] << G4endl;
+            return 1;
+
+        }
+
+    }
+
+    // The repetitions are optional, the options start with "--"
+    G4int repetitions = 10;
+    G4int firstOption = 2;
+    if (argc > 2 && std::string(argv[2]).rfind("--", 0) != 0) {
+
+        repetitions = std::stoi(argv[2]);
+        firstOption = 3;
+
+    }
+    if (repetitions < 1) {
+
+        G4cerr << "The number of repetitions must be positive" << G4endl;
+        return 1;
+
+    }
+    RunOptions options = ParseRunOptions(argc, argv, firstOption);
+    if (options.sourceMode == SourceMode::Field) {
+
+        G4Exception("stepReplay", "B1Replay001", FatalException,
+            "The field source needs the primary of each event, which is not recorded");
+
+    }
+    if (!options.stepRecordFile.empty()) {
+
+        G4Exception("stepReplay", "B1Replay002", FatalException,
+            "The replayed steps have no track to record");
+
+    }
+
+    // Real geometry, for the scoring volume pointers
+    DetectorConstruction detector;
+    G4VPhysicalVolume* world = detector.Construct();
+    G4LogicalVolume* volumes[3] = {
+        G4LogicalVolumeStore::GetInstance()->GetVolume("World"),
+        detector.GetScoringVolumePlastic(),
+        detector.GetScoringVolumeGAGG()
+    };
+
+    // Touchable of each volume, located by the navigator at the first
+    // recorded pre-step point found inside it. Points on a boundary belong to
+    // the volume being entered, which the navigator cannot tell without the
+    // direction, so the recorded volume decides which touchable a step gets.
+    G4Navigator navigator;
+    navigator.SetWorldVolume(world);
+    G4TouchableHandle touchables[3];
+    G4bool located[3] = {false, false, false};
+    G4bool used[3] = {false, false, false};
+    for (const auto& step : steps) {
+
+        used[step.volume] = true;
+        if (located[step.volume]) continue;
+
+        G4VPhysicalVolume* physical = navigator.LocateGlobalPointAndSetup(G4ThreeVector(step.x, step.y, step.z), nullptr, false, true);
+        if (physical && physical->GetLogicalVolume() == volumes[step.volume]) {
+
+            touchables[step.volume] = navigator.CreateTouchableHistoryHandle();
+            located[step.volume] = true;
+
+        }
+
+    }
+    for (G4int volume = 0; volume < 3; ++volume) {
+
+        if (used[volume] && !located[volume]) {
+
+            G4Exception("stepReplay", "B1Replay003", FatalException,
+                ("No recorded step lies inside " + volumes[volume]->GetName()
+                + ", the recording does not match the geometry").c_str());
+
+        }
+
+    }
+
+    // Scoring chain as built for a worker
+    std::unique_ptr<const LightModel> lightModelPlastic;
+    std::unique_ptr<const LightModel> lightModelGAGG;
+    if (options.lightModel) {
+
+        lightModelPlastic = std::make_unique<const LightModel>(LightModel::Plastic());
+        lightModelGAGG = std::make_unique<const LightModel>(LightModel::GAGG());
+
+    }
+
+    // Events are timed by the benchmark, not by the event action
+    RunAction runAction(options);
+    EventAction eventAction(&runAction, options, lightModelPlastic.get(), lightModelGAGG.get());
+    eventAction.SetEventTiming(false);
+    SteppingAction steppingAction(&eventAction);
+    steppingAction.SetScoringVolumes(volumes[1], volumes[2]);
+
+    // One step object refilled from the records, as the stepping manager
+    // refills its own step between the calls of the stepping action
+    G4Step g4Step;
+    G4StepPoint* preStepPoint = g4Step.GetPreStepPoint();
+
+    auto replay = [&]() {
+
+        G4Event event;
+        const StepRecord* step = steps.data();
+        for (size_t i = 0; i < eventSizes.size(); ++i) {
+
+            event.SetEventID(static_cast<G4int>(i + 1));
+            eventAction.BeginOfEventAction(&event);
+            for (std::uint32_t k = 0; k < eventSizes[i]; ++k, ++step) {
+
+                preStepPoint->SetTouchableHandle(touchables[step->volume]);
+                preStepPoint->SetPosition(G4ThreeVector(step->x, step->y, step->z));
+                preStepPoint->SetGlobalTime(step->time);
+                g4Step.SetStepLength(step->stepLength);
+                g4Step.SetTotalEnergyDeposit(step->eDep);
+                steppingAction.UserSteppingAction(&g4Step);
+
+            }
+            eventAction.EndOfEventAction(&event);
+
+        }
+
+    };
+
+    // Warm up caches, then time the repetitions
+    replay();
+
+    auto start = std::chrono::steady_clock::now();
+    for (G4int i = 0; i < repetitions; ++i) replay();
+    std::chrono::duration<G4double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    G4double nSteps = static_cast<G4double>(steps.size()) * repetitions;
+    G4cout
+    << "Replayed " << steps.size() << " steps of " << eventSizes.size() << " events " << repetitions << " times"
+    << (options.lightModel ? " with the light model" : "")
+    << G4endl
+    << "Scoring cost: " << elapsed.count() / nSteps << " ns/step, "
+    << elapsed.count() / (static_cast<G4double>(eventSizes.size()) * repetitions) << " ns/event"
+    << G4endl;
+
+    return 0;
+
+}
@@ -0,0 +1,47 @@
+/// \file B1/tests/TestCheck.hh
+/// \brief Checks shared by the unit tests
+
+#ifndef B1TestCheck_h
+#define B1TestCheck_h 1
+
+#include "globals.hh"
+
+#include <cmath>
+
+namespace B1{
+
+    namespace Test{
+
+        /// Failed checks of the running test; a test returns nonzero if any.
+
+        inline G4int failures = 0;
+
+        inline void Check(G4bool passed, const char* condition, const char* file, G4int line){
+
+            if (passed) return;
+
+            ++failures;
+            G4cerr << file << ":" << line << ": check failed: " << condition << G4endl;
+
+        }
+
+        inline G4bool Close(G4double value, G4double expected, G4double tolerance){
+
+            return std::abs(value - expected) <= tolerance * std::max(1., std::abs(expected));
+
+        }
+
+        inline int Result(){
+
+            if (failures > 0) G4cerr << failures << " checks failed" << G4endl;
+            return failures > 0 ? 1 : 0;
+
+        }
+
+    }
+
+}
+
+#define B1_CHECK(condition) B1::Test::Check((condition), #condition, __FILE__, __LINE__)
+
+#endif
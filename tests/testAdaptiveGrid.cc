@@ -0,0 +1,66 @@
+/// \file B1/tests/testAdaptiveGrid.cc
+/// \brief Interpolation significance of the adaptive energy grid
+
+#include "AdaptiveGrid.hh"
+
+#include "TestCheck.hh"
+
+#include <cmath>
+
+using namespace B1;
+
+namespace {
+
+    // Point with the given mean deposits per event and a relative
+    // uncertainty of the mean of 1% in both volumes
+    GridPoint MakePoint(G4double energy, G4double meanGAGG, G4double meanPlastic){
+
+        GridPoint point;
+        point.energy = energy;
+        point.logEnergy = std::log10(energy / MeV);
+
+        // rms of the sum = sqrt(M2) = 0.01 sum
+        G4long n = 10000;
+        DoseSums& sums = point.sums;
+        sums.nEvents = n;
+        sums.eDepGAGG = meanGAGG * n;
+        sums.eDepM2GAGG = std::pow(0.01 * sums.eDepGAGG, 2);
+        sums.eDepPlastic = meanPlastic * n;
+        sums.eDepM2Plastic = std::pow(0.01 * sums.eDepPlastic, 2);
+        return point;
+
+    }
+
+}
+
+int main(){
+
+    // Deposits following a power law are interpolated exactly in log-log
+    auto powerLaw = [](G4double energy) { return 0.3 * std::pow(energy / MeV, 0.7); };
+    GridPoint left = MakePoint(0.1 * MeV, powerLaw(0.1 * MeV), 2. * powerLaw(0.1 * MeV));
+    GridPoint point = MakePoint(0.3 * MeV, powerLaw(0.3 * MeV), 2. * powerLaw(0.3 * MeV));
+    GridPoint right = MakePoint(1. * MeV, powerLaw(1. * MeV), 2. * powerLaw(1. * MeV));
+    B1_CHECK(InterpolationSignificance(left, point, right) < 1.e-6);
+
+    // A 10% step in one volume is ten times its own 1% uncertainty, combined
+    // with the neighbours' in quadrature
+    GridPoint shifted = MakePoint(0.3 * MeV, powerLaw(0.3 * MeV), 2.2 * powerLaw(0.3 * MeV));
+    G4double w = (shifted.logEnergy - left.logEnergy) / (right.logEnergy - left.logEnergy);
+    G4double sigma = 0.01 * std::sqrt(1. + (1. - w) * (1. - w) + w * w);
+    B1_CHECK(Test::Close(InterpolationSignificance(left, shifted, right), std::log(1.1) / sigma, 1.e-6));
+
+    // Points of different statistics compare by their means
+    GridPoint rescaled = MakePoint(0.3 * MeV, powerLaw(0.3 * MeV), 2. * powerLaw(0.3 * MeV));
+    rescaled.sums.Merge(rescaled.sums);
+    B1_CHECK(InterpolationSignificance(left, rescaled, right) < 1.e-6);
+
+    // Without deposits the interpolation is linear, and a point on the line
+    // is not significant
+    GridPoint empty = MakePoint(0.3 * MeV, 0., 0.);
+    GridPoint emptyLeft = MakePoint(0.1 * MeV, 0., 0.);
+    GridPoint emptyRight = MakePoint(1. * MeV, 0., 0.);
+    B1_CHECK(InterpolationSignificance(emptyLeft, empty, emptyRight) == 0.);
+
+    return Test::Result();
+
+}
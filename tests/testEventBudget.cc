@@ -0,0 +1,56 @@
+/// \file B1/tests/testEventBudget.cc
+/// \brief Budgeted event allocation equalises the relative uncertainties
+
+#include "EventBudget.hh"
+
+#include "TestCheck.hh"
+
+using namespace B1;
+
+int main(){
+
+    // Two points of equal cost, the second four times as noisy
+    std::vector<PilotEstimate> pilots(2);
+    pilots[0] = {1000, 1.e-3, 1.};
+    pilots[1] = {1000, 1.e-3, 4.};
+
+    G4double seconds = 8.;
+    std::vector<G4long> events = AllocateEvents(pilots, seconds);
+
+    // Equal relative variance c / n, and the budget spent on the extra events
+    B1_CHECK(Test::Close(events[1], 4. * events[0], 1.e-3));
+    G4double spent = (events[0] - pilots[0].nEvents) * pilots[0].secondsPerEvent
+                   + (events[1] - pilots[1].nEvents) * pilots[1].secondsPerEvent;
+    B1_CHECK(spent <= seconds && spent > seconds - 2.e-3);
+
+    // A point whose pilot already beats the common level keeps its pilot,
+    // the others share the whole budget
+    pilots.push_back({1000000, 1.e-3, 1.});
+    events = AllocateEvents(pilots, seconds);
+    B1_CHECK(events[2] == 1000000);
+    B1_CHECK(Test::Close(events[1], 4. * events[0], 1.e-3));
+
+    // Points without deposits or without a measured cost are not refined
+    pilots = {{100, 0., 1.}, {100, 1.e-3, 0.}, {100, 1.e-3, 1.}};
+    events = AllocateEvents(pilots, 1.);
+    B1_CHECK(events[0] == 100 && events[1] == 100);
+    B1_CHECK(events[2] == 1100);
+
+    // No time left: the pilots stay as they are
+    events = AllocateEvents(pilots, 0.);
+    B1_CHECK(events[0] == 100 && events[1] == 100 && events[2] == 100);
+
+    // The relative variance of the sums is the worst of both volumes times
+    // the number of events
+    DoseSums sums;
+    sums.nEvents = 4;
+    sums.eDepGAGG = 4.;
+    sums.eDepM2GAGG = 0.;
+    sums.eDepPlastic = 4.;
+    sums.eDepM2Plastic = 4.;
+    G4double relative = sums.RmsEDepPlastic() / sums.eDepPlastic;
+    B1_CHECK(Test::Close(RelativeVariance(sums), relative * relative * sums.nEvents, 1.e-12));
+
+    return Test::Result();
+
+}
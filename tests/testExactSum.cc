@@ -0,0 +1,104 @@
+/// \file B1/tests/testExactSum.cc
+/// \brief Merged fixed-point sums are independent of the merge order, and
+/// their M2 is free of cancellation
+
+#include "DoseSums.hh"
+#include "ExactSum.hh"
+
+#include "TestCheck.hh"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace B1;
+
+int main(){
+
+    std::mt19937_64 engine(1);
+    std::exponential_distribution<G4double> deposit(1.);
+    std::vector<G4double> values(10000);
+    for (auto& value : values) value = deposit(engine);
+
+    // One thread, and the same values spread round robin over four threads
+    // merged in reverse order
+    ExactSum serial;
+    for (G4double value : values) serial.Add(value);
+
+    std::vector<ExactSum> threads(4);
+    for (size_t i = 0; i < values.size(); ++i) threads[i % threads.size()].Add(values[i]);
+    ExactSum merged;
+    for (auto thread = threads.rbegin(); thread != threads.rend(); ++thread) merged.Merge(*thread);
+
+    B1_CHECK(merged.GetN() == serial.GetN());
+    B1_CHECK(merged.GetSum() == serial.GetSum());
+    B1_CHECK(merged.GetM2() == serial.GetM2());
+
+    // The sums agree with two-pass sums to the fixed-point resolution: half a
+    // quantum per value, and |x - mean| quanta per squared deviation
+    auto twoPass = [](const std::vector<G4double>& x, G4double& sum, G4double& m2) {
+
+        long double total = 0.;
+        for (G4double value : x) total += value;
+        long double mean = total / x.size();
+        long double deviations = 0.;
+        long double absolute = 0.;
+        for (G4double value : x) {
+
+            deviations += (value - mean) * (value - mean);
+            absolute += std::abs(value - mean);
+
+        }
+        sum = static_cast<G4double>(total);
+        m2 = static_cast<G4double>(deviations);
+        return static_cast<G4double>(absolute);
+
+    };
+    G4double sum = 0.;
+    G4double m2 = 0.;
+    G4double absolute = twoPass(values, sum, m2);
+    B1_CHECK(std::abs(serial.GetSum() - sum) <= 0.5 * ExactSum::fQuantum * values.size());
+    B1_CHECK(std::abs(serial.GetM2() - m2) <= ExactSum::fQuantum * absolute);
+
+    // A small spread on a large offset, where the sum of squares minus the
+    // squared sum over n loses every digit in double precision
+    std::uniform_real_distribution<G4double> spread(0., 1.e-3);
+    std::vector<G4double> offset(10000);
+    for (auto& value : offset) value = 1000. + spread(engine);
+    ExactSum shifted;
+    for (G4double value : offset) shifted.Add(value);
+    absolute = twoPass(offset, sum, m2);
+    B1_CHECK(std::abs(shifted.GetM2() - m2) <= ExactSum::fQuantum * absolute);
+    B1_CHECK(Test::Close(shifted.GetM2(), m2, 1.e-5));
+
+    // Sums of separate runs combine to the M2 of a single run
+    DoseSums runs;
+    for (size_t first : {size_t(0), size_t(3000)}) {
+
+        ExactSum part;
+        for (size_t i = first; i < (first == 0 ? 3000 : offset.size()); ++i) part.Add(offset[i]);
+        DoseSums run;
+        run.nEvents = part.GetN();
+        run.eDepGAGG = part.GetSum();
+        run.eDepM2GAGG = part.GetM2();
+        runs.Merge(run);
+
+    }
+    B1_CHECK(runs.nEvents == shifted.GetN());
+    B1_CHECK(Test::Close(runs.RmsEDepGAGG(), std::sqrt(shifted.GetM2()), 1.e-9));
+
+    // Values below half a quantum vanish, negative values subtract
+    ExactSum small;
+    small.Add(0.4 * ExactSum::fQuantum);
+    B1_CHECK(small.GetSum() == 0.);
+    small.Add(2.);
+    small.Add(-0.5);
+    B1_CHECK(Test::Close(small.GetSum(), 1.5, 1.e-15));
+    B1_CHECK(Test::Close(small.GetM2(), 4.25 - 1.5 * 1.5 / 3., 1.e-15));
+
+    small.Reset();
+    B1_CHECK(small.GetN() == 0 && small.GetSum() == 0. && small.GetM2() == 0.);
+
+    return Test::Result();
+
+}
@@ -0,0 +1,127 @@
+/// \file B1/tests/testFieldSource.cc
+/// \brief Geometric weights and bins of the field source, and its comparison with the pencil beam
+
+#include "DirectionalTally.hh"
+#include "FieldValidation.hh"
+#include "PrimaryGeneratorAction.hh"
+
+#include "TestCheck.hh"
+
+#include <filesystem>
+#include <fstream>
+
+using namespace B1;
+
+int main(){
+
+    const G4double plasticRadius = 1.05 * cm;
+    const G4double plasticHalfZ = 1. * cm;
+    G4double boundingRadius = PrimaryGeneratorAction::BoundingRadius(plasticRadius, plasticHalfZ);
+    B1_CHECK(Test::Close(boundingRadius, std::sqrt(1.05 * 1.05 + 1.) * cm, 1e-12));
+
+    // Per photon for the pencil, per unit fluence in cm2 for the beam and the
+    // field, and the solid angle fraction of the cone of the point source
+    RunOptions options;
+    B1_CHECK(PrimaryGeneratorAction::GeometricWeight(options, plasticRadius, plasticHalfZ) == 1.);
+    B1_CHECK(PrimaryGeneratorAction::SourceExtent(options, plasticRadius, plasticHalfZ) == 0.);
+
+    for (SourceMode mode : {SourceMode::Beam, SourceMode::Field}) {
+
+        options.sourceMode = mode;
+        G4double area = CLHEP::pi * boundingRadius * boundingRadius / cm2;
+        B1_CHECK(Test::Close(PrimaryGeneratorAction::GeometricWeight(options, plasticRadius, plasticHalfZ), area, 1e-12));
+        B1_CHECK(Test::Close(PrimaryGeneratorAction::SourceExtent(options, plasticRadius, plasticHalfZ), std::sqrt(2.) * boundingRadius, 1e-12));
+
+    }
+
+    options.sourceMode = SourceMode::Point;
+    options.sourceDistance = 2. * boundingRadius;
+    B1_CHECK(Test::Close(PrimaryGeneratorAction::GeometricWeight(options, plasticRadius, plasticHalfZ), 0.5 * (1. - std::sqrt(0.75)), 1e-12));
+    B1_CHECK(PrimaryGeneratorAction::SourceExtent(options, plasticRadius, plasticHalfZ) == options.sourceDistance);
+
+    // Field directions are unit vectors with cos(theta) uniform in u1, and
+    // every ray starts on the tangent plane of the bounding sphere within the
+    // launch disk, inside the world extent
+    G4double extent = std::sqrt(2.) * boundingRadius;
+    for (G4double u1 : {0., 0.1, 0.5, 0.9, 1.}) {
+
+        for (G4double u2 : {0., 0.3, 0.999}) {
+
+            G4ThreeVector axis = PrimaryGeneratorAction::FieldDirection(u1, u2);
+            B1_CHECK(Test::Close(axis.mag(), 1., 1e-12));
+            B1_CHECK(Test::Close(axis.z(), 2. * u1 - 1., 1e-12));
+
+            G4ThreeVector start = PrimaryGeneratorAction::BeamStart(axis, boundingRadius, u2, u1);
+            B1_CHECK(Test::Close(start.dot(axis), -boundingRadius, 1e-12));
+            B1_CHECK((start + boundingRadius * axis).mag() <= boundingRadius * (1. + 1e-12));
+            B1_CHECK(start.mag() <= extent * (1. + 1e-12));
+
+        }
+
+    }
+
+    // Equal cos(theta) bins, the last one along +z
+    B1_CHECK(DirectionalTally::Bin(G4ThreeVector(0., 0., -1.), 10) == 0);
+    B1_CHECK(DirectionalTally::Bin(G4ThreeVector(0., 0., 1.), 10) == 9);
+    B1_CHECK(DirectionalTally::Bin(G4ThreeVector(1., 0., 0.), 10) == 5);
+    B1_CHECK(DirectionalTally::Bin(G4ThreeVector(0., 0., 1.), 1) == 0);
+
+    // Energies of a field run alternate over its events, in blocks of the
+    // direction bins of each energy in the tally
+    PrimaryGeneratorAction::SetFieldEnergies({1. * MeV, 2. * MeV, 3. * MeV});
+    B1_CHECK(PrimaryGeneratorAction::FieldEnergyIndex(7) == 1);
+    DirectionalTally tally("Field", 4);
+    tally.SetNumberOfEnergies(static_cast<G4int>(PrimaryGeneratorAction::GetFieldEnergies().size()));
+    PrimaryGeneratorAction::SetFieldEnergies({});
+    B1_CHECK(PrimaryGeneratorAction::FieldEnergyIndex(7) == 0);
+
+    tally.Add(1 * 4 + 3, 2., 5.);
+    tally.Add(1 * 4 + 3, 4., 5.);
+    DirectionalTally other("Field", 4);
+    other.SetNumberOfEnergies(3);
+    other.Add(1 * 4 + 3, 6., 5.);
+    tally.Merge(other);
+
+    std::vector<G4double> values = tally.GetValues();
+    B1_CHECK(values.size() == 3 * 4 * DirectionalTally::fNValues);
+    const G4double* bin = &values[(1 * 4 + 3) * DirectionalTally::fNValues];
+    B1_CHECK(bin[0] == 3. && Test::Close(bin[1], 12., 1e-12) && Test::Close(bin[2], 8., 1e-12) && Test::Close(bin[3], 15., 1e-12) && bin[4] == 0.);
+    B1_CHECK(values[0] == 0.);
+
+    // The field bin along +z against the pencil dose per event times the face
+    // area, from the files of both sweeps
+    auto directory = std::filesystem::temp_directory_path() / "B1testFieldSource";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory / "field");
+    std::filesystem::create_directories(directory / "pencil");
+    {
+
+        std::ofstream response(directory / "field" / "response.txt");
+        response << "Dose per unit fluence\n" << "photonEnergy / MeV\tcosThetaMin\tcosThetaMax\tnEvents\n";
+        response << "1\t-1\t0\t100\t9\t1\t9\t1\n";
+        response << "1\t0\t1\t100\t2\t0.3\t6\t0.4\n";
+        response << "2\t0\t1\t100\t1\t0.1\t1\t0.1\n";
+
+        // Totals over 1000 events in a plastic of radius 1/sqrt(pi) cm
+        std::ofstream output(directory / "pencil" / "output.txt");
+        output << "Plastic:\n" << "photonEnergy / MeV\tnEvents\n";
+        output << "1\t1000\t0\t0\t0\t0\t2500\t400\t5000\t300\n";
+
+    }
+
+    auto deviations = CompareFieldWithPencil(directory / "field", directory / "pencil", cm / std::sqrt(CLHEP::pi));
+    B1_CHECK(deviations.size() == 1);
+    if (deviations.size() == 1) {
+
+        const FieldDeviation& deviation = deviations.front();
+        B1_CHECK(deviation.energy == 1. && deviation.nEventsField == 100. && deviation.nEventsPencil == 1000.);
+        B1_CHECK(Test::Close(deviation.pencilGAGG, 2.5, 1e-12) && Test::Close(deviation.dPencilGAGG, 0.4, 1e-12));
+        B1_CHECK(Test::Close(deviation.zGAGG, -1., 1e-12));
+        B1_CHECK(Test::Close(deviation.pencilPlastic, 5., 1e-12) && Test::Close(deviation.zPlastic, 2., 1e-12));
+
+    }
+    std::filesystem::remove_all(directory);
+
+    return Test::Result();
+
+}
@@ -0,0 +1,73 @@
+/// \file B1/tests/testPileUp.cc
+/// \brief Pulse counting of the pile-up synthesis
+
+#include "PileUp.hh"
+
+#include "TestCheck.hh"
+
+using namespace B1;
+
+int main(){
+
+    // Library of one energy: one event in four deposits nothing, the others
+    // 100 keV in GAGG or 500 keV in the plastic
+    std::vector<EventRecord> library;
+    for (G4int i = 0; i < 4000; ++i) {
+
+        EventRecord record;
+        record.energy = 1. * MeV;
+        if (i % 4 == 1) record.eDepGAGG = 100. * keV;
+        if (i % 4 >= 2) record.eDepPlastic = 500. * keV;
+        library.push_back(record);
+
+    }
+
+    PileUpSettings settings;
+    settings.nPulses = 20000;
+    settings.deadTime = 0.;
+
+    PileUpSynthesizer synthesizer(library, 1. * MeV, settings);
+    B1_CHECK(synthesizer.GetNumberOfEvents() == 4000);
+    B1_CHECK(synthesizer.GetNumberOfDepositingEvents() == 3000);
+
+    // Far below the inverse shaping time nothing piles up, and the real time
+    // follows the depositing rate
+    G4double rate = 100. / second;
+    PileUpSpectrum spectrum = synthesizer.Synthesize(rate);
+    B1_CHECK(spectrum.nPulses == settings.nPulses);
+    B1_CHECK(spectrum.nPiledUp < 10);
+    B1_CHECK(Test::Close(spectrum.realTime * 0.75 * rate, settings.nPulses, 0.03));
+
+    // The same rate gives the same spectrum
+    PileUpSpectrum again = synthesizer.Synthesize(rate);
+    B1_CHECK(again.realTime == spectrum.realTime && again.eDepGAGG == spectrum.eDepGAGG);
+
+    // At one arrival per shaping time a pulse collects further arrivals with
+    // probability 1 - exp(-1)
+    spectrum = synthesizer.Synthesize(1. / (0.75 * settings.shapingTime));
+    G4double pileUpFraction = static_cast<G4double>(spectrum.nPiledUp) / spectrum.nPulses;
+    B1_CHECK(Test::Close(pileUpFraction, 1. - std::exp(-1.), 0.05));
+
+    // Events below the threshold open no pulse and are counted apart
+    settings.threshold = 200. * keV;
+    PileUpSynthesizer thresholded(library, 1. * MeV, settings);
+    B1_CHECK(thresholded.GetNumberOfEventsAboveThreshold() == 2000);
+    spectrum = thresholded.Synthesize(rate);
+    B1_CHECK(spectrum.nPulses == settings.nPulses);
+    B1_CHECK(Test::Close(spectrum.nBelowThreshold, 0.5 * settings.nPulses, 0.05));
+
+    // Only piled-up pulses can then carry a GAGG deposit
+    G4double pulsesGAGG = 0.;
+    for (G4double counts : spectrum.eDepGAGG) pulsesGAGG += counts * spectrum.realTime / second;
+    B1_CHECK(pulsesGAGG <= spectrum.nPiledUp + 0.5);
+
+    // A threshold above every event ends at once with an empty spectrum
+    settings.threshold = 1. * MeV;
+    PileUpSynthesizer silent(library, 1. * MeV, settings);
+    B1_CHECK(silent.GetNumberOfEventsAboveThreshold() == 0);
+    spectrum = silent.Synthesize(rate);
+    B1_CHECK(spectrum.nPulses == 0 && spectrum.realTime == 0.);
+
+    return Test::Result();
+
+}
@@ -0,0 +1,74 @@
+/// \file B1/tests/testResultCache.cc
+/// \brief Round trip of the result cache and rejection of other configurations
+
+#include "ResultCache.hh"
+
+#include "TestCheck.hh"
+
+#include <filesystem>
+
+using namespace B1;
+
+int main(){
+
+    auto directory = std::filesystem::temp_directory_path() / "B1testResultCache";
+    std::filesystem::remove_all(directory);
+
+    DoseSums sums;
+    sums.nEvents = 1000;
+    sums.eDepGAGG = 1. / 3.;
+    sums.eDepM2GAGG = 0.01;
+    sums.eDepPlastic = 2. / 3.;
+    sums.eDepM2Plastic = 0.02;
+    sums.lightGAGG = 100.;
+    sums.lightM2GAGG = 20.;
+    sums.lightPlastic = 50.;
+    sums.lightM2Plastic = 5.;
+    sums.profileGAGG = {1., 2., 3.};
+    sums.profilePlastic = {4., 5., 6.};
+    sums.directional = {10., 0.1, 0.01, 0.2, 0.04};
+    for (G4double value : {0.1, 0.4, 0.2}) {
+
+        sums.statsGAGG.Add(value);
+        sums.statsPlastic.Add(2. * value);
+
+    }
+    sums.nEvents = 3;
+    sums.batches = {3., 0.7, 1.4};
+    sums.seconds = 12.5;
+    sums.nSteps = 123456;
+
+    G4double energy = 0.662 * MeV;
+    ResultCache cache(directory.string(), "geometry=a;physics=b");
+    DoseSums found;
+    B1_CHECK(!cache.Lookup(energy, found));
+
+    cache.Store(energy, sums);
+    B1_CHECK(cache.Lookup(energy, found));
+
+    // Every block comes back at full precision
+    B1_CHECK(found.nEvents == sums.nEvents);
+    B1_CHECK(found.eDepGAGG == sums.eDepGAGG && found.eDepM2GAGG == sums.eDepM2GAGG);
+    B1_CHECK(found.eDepPlastic == sums.eDepPlastic && found.eDepM2Plastic == sums.eDepM2Plastic);
+    B1_CHECK(found.lightGAGG == sums.lightGAGG && found.lightM2Plastic == sums.lightM2Plastic);
+    B1_CHECK(found.profileGAGG == sums.profileGAGG && found.profilePlastic == sums.profilePlastic);
+    B1_CHECK(found.directional == sums.directional);
+    B1_CHECK(found.statsGAGG.n == 3 && found.statsGAGG.m4 == sums.statsGAGG.m4);
+    B1_CHECK(found.statsPlastic.mean == sums.statsPlastic.mean);
+    B1_CHECK(found.batches == sums.batches);
+    B1_CHECK(found.seconds == sums.seconds && found.nSteps == sums.nSteps);
+
+    // Another energy, even a close one, or another configuration misses
+    B1_CHECK(!cache.Lookup(std::nextafter(energy, 1.), found));
+    ResultCache other(directory.string(), "geometry=a;physics=c");
+    B1_CHECK(!other.Lookup(energy, found));
+
+    // A later store replaces the entry
+    sums.nEvents = 6;
+    cache.Store(energy, sums);
+    B1_CHECK(cache.Lookup(energy, found) && found.nEvents == 6);
+
+    std::filesystem::remove_all(directory);
+    return Test::Result();
+
+}
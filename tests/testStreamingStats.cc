@@ -0,0 +1,76 @@
+/// \file B1/tests/testStreamingStats.cc
+/// \brief Merged streaming moments agree with the two-pass moments
+
+#include "StreamingStats.hh"
+
+#include "TestCheck.hh"
+
+#include <random>
+#include <vector>
+
+using namespace B1;
+
+int main(){
+
+    // Skewed values on a large offset, where sum-of-powers moments lose
+    // every digit
+    std::mt19937_64 engine(2);
+    std::gamma_distribution<G4double> gamma(2., 1.);
+    std::vector<G4double> values(20000);
+    for (auto& value : values) value = 1.e6 + gamma(engine);
+
+    G4double mean = 0.;
+    for (G4double value : values) mean += value;
+    mean /= values.size();
+    G4double m2 = 0.;
+    G4double m3 = 0.;
+    G4double m4 = 0.;
+    for (G4double value : values) {
+
+        G4double d = value - mean;
+        m2 += d * d;
+        m3 += d * d * d;
+        m4 += d * d * d * d;
+
+    }
+
+    // Sequential, and three uneven parts merged
+    StreamingStats serial;
+    for (G4double value : values) serial.Add(value);
+
+    StreamingStats parts[3];
+    for (size_t i = 0; i < values.size(); ++i) parts[i < 1000 ? 0 : (i < 15000 ? 1 : 2)].Add(values[i]);
+    StreamingStats merged;
+    merged.Merge(parts[2]);
+    merged.Merge(parts[0]);
+    merged.Merge(parts[1]);
+
+    for (const StreamingStats* stats : {&serial, &merged}) {
+
+        B1_CHECK(stats->n == static_cast<G4long>(values.size()));
+        B1_CHECK(Test::Close(stats->mean, mean, 1.e-14));
+        B1_CHECK(Test::Close(stats->m2, m2, 1.e-8));
+        B1_CHECK(Test::Close(stats->m3, m3, 1.e-6));
+        B1_CHECK(Test::Close(stats->m4, m4, 1.e-8));
+
+    }
+
+    // Gamma(2): skewness sqrt(2), excess kurtosis 3
+    B1_CHECK(Test::Close(merged.Skewness(), std::sqrt(2.), 0.1));
+    B1_CHECK(Test::Close(merged.ExcessKurtosis(), 3., 0.3));
+
+    // Merging with an empty set changes nothing
+    StreamingStats copy = merged;
+    copy.Merge(StreamingStats());
+    B1_CHECK(copy.n == merged.n && copy.mean == merged.mean && copy.m2 == merged.m2);
+
+    // A constant weight scales the moments by its powers
+    StreamingStats scaled = merged;
+    scaled.Scale(2.);
+    B1_CHECK(Test::Close(scaled.mean, 2. * merged.mean, 1.e-14));
+    B1_CHECK(Test::Close(scaled.Variance(), 4. * merged.Variance(), 1.e-12));
+    B1_CHECK(Test::Close(scaled.VarianceOfVariance(), merged.VarianceOfVariance(), 1.e-12));
+
+    return Test::Result();
+
+}